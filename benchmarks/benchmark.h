@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+
+#define BENCHMARK_ITERATIONS 1000000
+
+#define BENCHMARK_SYSCALL_ITERATIONS 10000
+
+#define BENCHMARK_PRINT(...)                                                   \
+  do {                                                                         \
+    (void) printf(__VA_ARGS__);                                                \
+    (void) fflush(stdout);                                                     \
+  } while(0)
+
+#define BENCHMARK_TITLE(title)                                                 \
+  BENCHMARK_PRINT("\n%s\n\n", title)
+
+/**
+ * Returns the current value of the monotonic clock, in nanoseconds.
+ */
+static inline double benchmark_now(void) {
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec * 1e9 + (double) now.tv_nsec;
+}
+
+/**
+ * Measures the average time it takes to run one iteration of a benchmark.
+ *
+ * @param run the function that runs the benchmark.
+ * @param iterations the number of iterations to run.
+ * @return the average number of nanoseconds per iteration.
+ */
+static inline double benchmark_time(void (*run)(int), const int iterations) {
+    run(iterations / 10);
+    const double start = benchmark_now();
+    run(iterations);
+    return (benchmark_now() - start) / iterations;
+}
+
+/**
+ * Runs a benchmark in a child process and counts the system calls it makes.
+ *
+ * @param run the function that runs the benchmark.
+ * @param iterations the number of iterations to run.
+ * @return the number of system calls made, or -1 if they could not be traced.
+ */
+static inline long benchmark_trace(void (*run)(int), const int iterations) {
+    const pid_t child = fork();
+    if (child == 0) {
+        if (ptrace(PTRACE_TRACEME, 0, NULL, NULL) != 0) {
+            _exit(EXIT_FAILURE);
+        }
+        (void) raise(SIGSTOP);
+        run(iterations);
+        _exit(EXIT_SUCCESS);
+    }
+    int status;
+    long stops = 0;
+    if (child < 0 || waitpid(child, &status, 0) != child || !WIFSTOPPED(status)) {
+        return -1;
+    }
+    /* every system call stops the child twice: on entry and on exit */
+    while (ptrace(PTRACE_SYSCALL, child, NULL, NULL) == 0 && waitpid(child, &status, 0) == child && WIFSTOPPED(status)) {
+        stops++;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS ? stops / 2 : -1;
+}
+
+/**
+ * Measures the average number of system calls made by one iteration of a benchmark.
+ *
+ * @param run the function that runs the benchmark.
+ * @param iterations the number of iterations to run.
+ * @return the average number of system calls per iteration, or a negative number if they could not be traced.
+ */
+static inline double benchmark_syscalls(void (*run)(int), const int iterations) {
+    const long baseline = benchmark_trace(run, 0);
+    const long total = benchmark_trace(run, iterations);
+    return baseline < 0 || total < 0 ? -1 : (double) (total - baseline) / iterations;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+#define MAX_DEPTH 32
+
+/* one hierarchy of thrown exception types, another one of unrelated types */
+static struct e4c_exception_type thrown[MAX_DEPTH + 1];
+static struct e4c_exception_type unrelated[MAX_DEPTH + 1];
+static struct e4c_type_display thrown_displays[MAX_DEPTH + 1];
+static struct e4c_type_display unrelated_displays[MAX_DEPTH + 1];
+
+static int depth = 0;
+static volatile int counter = 0;
+
+static void build_hierarchy(struct e4c_exception_type *, struct e4c_type_display *, bool);
+static void run_ladder(int);
+
+/**
+ * Measures the cost of a CATCH ladder, depending on the depth of the type hierarchy.
+ */
+int main(void) {
+    static const int depths[] = {2, 8, 32};
+    BENCHMARK_TITLE("CATCH ladder: 8 mismatches, then the root type");
+    BENCHMARK_PRINT("%-40s %12s %12s\n", "depth", "walk (ns)", "display (ns)");
+    for (size_t index = 0; index < sizeof(depths) / sizeof(depths[0]); index++) {
+        depth = depths[index];
+        build_hierarchy(thrown, thrown_displays, false);
+        build_hierarchy(unrelated, unrelated_displays, false);
+        const double walk = benchmark_time(run_ladder, BENCHMARK_ITERATIONS);
+        build_hierarchy(thrown, thrown_displays, true);
+        build_hierarchy(unrelated, unrelated_displays, true);
+        const double display = benchmark_time(run_ladder, BENCHMARK_ITERATIONS);
+        BENCHMARK_PRINT("%-40d %12.1f %12.1f\n", depth, walk, display);
+    }
+    return EXIT_SUCCESS;
+}
+
+static void build_hierarchy(struct e4c_exception_type * types, struct e4c_type_display * displays, const bool registered) {
+    for (int index = 0; index <= depth; index++) {
+        types[index].supertype = index > 0 ? &types[index - 1] : NULL;
+        types[index].default_message = "Oops";
+        types[index].display = registered ? &displays[index] : NULL;
+        displays[index].ancestors = NULL;
+    }
+    if (registered) {
+        (void) e4c_register_type(&types[depth]);
+    }
+}
+
+static void run_ladder(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            THROW(thrown[depth], NULL);
+        } CATCH (unrelated[depth]) {
+            counter--;
+        } CATCH (unrelated[depth - 1]) {
+            counter--;
+        } CATCH (unrelated[depth - 2]) {
+            counter--;
+        } CATCH (unrelated[depth - 2]) {
+            counter--;
+        } CATCH (unrelated[1]) {
+            counter--;
+        } CATCH (unrelated[1]) {
+            counter--;
+        } CATCH (unrelated[0]) {
+            counter--;
+        } CATCH (unrelated[0]) {
+            counter--;
+        } CATCH (thrown[0]) {
+            counter++;
+        }
+    }
+}
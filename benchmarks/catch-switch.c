@@ -0,0 +1,116 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+/* a protocol error mapper with 40 exception types */
+#define PROTOCOL_ERRORS(ROOT, TYPE)                                         \
+  ROOT(PROTOCOL_ERROR, "Protocol error")                                    \
+  TYPE(ERROR_01, PROTOCOL_ERROR, "Error 1")                                 \
+  TYPE(ERROR_02, PROTOCOL_ERROR, "Error 2")                                 \
+  TYPE(ERROR_03, PROTOCOL_ERROR, "Error 3")                                 \
+  TYPE(ERROR_04, PROTOCOL_ERROR, "Error 4")                                 \
+  TYPE(ERROR_05, PROTOCOL_ERROR, "Error 5")                                 \
+  TYPE(ERROR_06, PROTOCOL_ERROR, "Error 6")                                 \
+  TYPE(ERROR_07, PROTOCOL_ERROR, "Error 7")                                 \
+  TYPE(ERROR_08, PROTOCOL_ERROR, "Error 8")                                 \
+  TYPE(ERROR_09, PROTOCOL_ERROR, "Error 9")                                 \
+  TYPE(ERROR_10, PROTOCOL_ERROR, "Error 10")                                \
+  TYPE(ERROR_11, PROTOCOL_ERROR, "Error 11")                                \
+  TYPE(ERROR_12, PROTOCOL_ERROR, "Error 12")                                \
+  TYPE(ERROR_13, PROTOCOL_ERROR, "Error 13")                                \
+  TYPE(ERROR_14, PROTOCOL_ERROR, "Error 14")                                \
+  TYPE(ERROR_15, PROTOCOL_ERROR, "Error 15")                                \
+  TYPE(ERROR_16, PROTOCOL_ERROR, "Error 16")                                \
+  TYPE(ERROR_17, PROTOCOL_ERROR, "Error 17")                                \
+  TYPE(ERROR_18, PROTOCOL_ERROR, "Error 18")                                \
+  TYPE(ERROR_19, PROTOCOL_ERROR, "Error 19")                                \
+  TYPE(ERROR_20, PROTOCOL_ERROR, "Error 20")                                \
+  TYPE(ERROR_21, PROTOCOL_ERROR, "Error 21")                                \
+  TYPE(ERROR_22, PROTOCOL_ERROR, "Error 22")                                \
+  TYPE(ERROR_23, PROTOCOL_ERROR, "Error 23")                                \
+  TYPE(ERROR_24, PROTOCOL_ERROR, "Error 24")                                \
+  TYPE(ERROR_25, PROTOCOL_ERROR, "Error 25")                                \
+  TYPE(ERROR_26, PROTOCOL_ERROR, "Error 26")                                \
+  TYPE(ERROR_27, PROTOCOL_ERROR, "Error 27")                                \
+  TYPE(ERROR_28, PROTOCOL_ERROR, "Error 28")                                \
+  TYPE(ERROR_29, PROTOCOL_ERROR, "Error 29")                                \
+  TYPE(ERROR_30, PROTOCOL_ERROR, "Error 30")                                \
+  TYPE(ERROR_31, PROTOCOL_ERROR, "Error 31")                                \
+  TYPE(ERROR_32, PROTOCOL_ERROR, "Error 32")                                \
+  TYPE(ERROR_33, PROTOCOL_ERROR, "Error 33")                                \
+  TYPE(ERROR_34, PROTOCOL_ERROR, "Error 34")                                \
+  TYPE(ERROR_35, PROTOCOL_ERROR, "Error 35")                                \
+  TYPE(ERROR_36, PROTOCOL_ERROR, "Error 36")                                \
+  TYPE(ERROR_37, PROTOCOL_ERROR, "Error 37")                                \
+  TYPE(ERROR_38, PROTOCOL_ERROR, "Error 38")                                \
+  TYPE(ERROR_39, PROTOCOL_ERROR, "Error 39")
+
+DECLARE_EXCEPTION_TYPES(PROTOCOL_ERRORS);
+DEFINE_EXCEPTION_TYPES(PROTOCOL_ERRORS);
+
+#define LADDER_ROOT(name, default_message)
+
+#define LADDER_TYPE(name, supertype, default_message)                       \
+  CATCH (name) {                                                            \
+    counter += name ## _ID;                                                 \
+  }
+
+#define SWITCH_ROOT(name, default_message)
+
+#define SWITCH_TYPE(name, supertype, default_message)                       \
+  CATCH_CASE (name)                                                         \
+    counter += name ## _ID;                                                 \
+    break;
+
+static volatile int counter = 0;
+
+static void run_ladder(int);
+static void run_switch(int);
+
+/**
+ * Compares a ladder of CATCH blocks against a CATCH_SWITCH block.
+ */
+int main(void) {
+    BENCHMARK_TITLE("Exception mapper: 40 types, the last one is thrown");
+    BENCHMARK_PRINT("%-40s %12s\n", "dispatch", "ns/block");
+    BENCHMARK_PRINT("%-40s %12.1f\n", "CATCH ladder", benchmark_time(run_ladder, BENCHMARK_ITERATIONS));
+    BENCHMARK_PRINT("%-40s %12.1f\n", "CATCH_SWITCH", benchmark_time(run_switch, BENCHMARK_ITERATIONS));
+    return EXIT_SUCCESS;
+}
+
+static void run_ladder(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            THROW(ERROR_39, NULL);
+        } PROTOCOL_ERRORS(LADDER_ROOT, LADDER_TYPE) CATCH (PROTOCOL_ERROR) {
+            counter--;
+        }
+    }
+}
+
+static void run_switch(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            THROW(ERROR_39, NULL);
+        } CATCH_SWITCH (PROTOCOL_ERRORS) {
+            PROTOCOL_ERRORS(SWITCH_ROOT, SWITCH_TYPE)
+            CATCH_DEFAULT
+                counter--;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdatomic.h>
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+static atomic_bool flag = false;
+static struct e4c_cancellation_token token;
+static volatile int counter = 0;
+
+static void run_plain(int);
+static void run_flag(int);
+static void run_checkpoint(int);
+static void report(const char *, void (*)(int));
+
+/**
+ * Measures the cost of a checkpoint in a hot loop that is not cancelled.
+ */
+int main(void) {
+    BENCHMARK_TITLE("Cancellation: cost per checkpoint");
+    BENCHMARK_PRINT("%-40s %12s\n", "check", "ns/iteration");
+    report("none", run_plain);
+    report("atomic flag (relaxed load)", run_flag);
+    report("CHECKPOINT (no token)", run_checkpoint);
+    (void) e4c_set_cancellation_token(e4c_get_context(), &token);
+    report("CHECKPOINT (token)", run_checkpoint);
+    return EXIT_SUCCESS;
+}
+
+static void report(const char * name, void (*run)(int)) {
+    BENCHMARK_PRINT("%-40s %12.1f\n", name, benchmark_time(run, BENCHMARK_ITERATIONS));
+}
+
+static void run_plain(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        counter++;
+    }
+}
+
+static void run_flag(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        if (atomic_load_explicit(&flag, memory_order_relaxed)) {
+            return;
+        }
+        counter++;
+    }
+}
+
+static void run_checkpoint(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        CHECKPOINT();
+        counter++;
+    }
+}
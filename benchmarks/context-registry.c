@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+#define CONTEXTS 64
+
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+static volatile int counter = 0;
+
+static void run_blocks(int);
+static void run_snapshots(int);
+static void run_scans(int);
+static void report(const struct e4c_context *, const struct e4c_block_snapshot *, void *);
+
+/**
+ * Measures the overhead of keeping registry counters and watched blocks, and the cost of taking a snapshot.
+ */
+int main(void) {
+    e4c_set_context_supplier(e4c_thread_context);
+    BENCHMARK_TITLE("Context registry: TRY/THROW/CATCH overhead");
+    BENCHMARK_PRINT("%-40s %12s\n", "registry", "time (ns)");
+    BENCHMARK_PRINT("%-40s %12.1f\n", "disabled", benchmark_time(run_blocks, BENCHMARK_ITERATIONS));
+    e4c_enable_context_registry();
+    e4c_register_context(e4c_get_context());
+    BENCHMARK_PRINT("%-40s %12.1f\n", "enabled", benchmark_time(run_blocks, BENCHMARK_ITERATIONS));
+
+    static struct e4c_context contexts[CONTEXTS];
+    for (int index = 0; index < CONTEXTS; index++) {
+        e4c_register_context(&contexts[index]);
+    }
+    BENCHMARK_TITLE("Context registry: snapshot of 66 contexts");
+    BENCHMARK_PRINT("%-40s %12s\n", "operation", "time (ns)");
+    BENCHMARK_PRINT("%-40s %12.1f\n", "e4c_get_statistics", benchmark_time(run_snapshots, BENCHMARK_ITERATIONS / 10));
+    BENCHMARK_PRINT("%-40s %12.1f\n", "e4c_watchdog_scan", benchmark_time(run_scans, BENCHMARK_ITERATIONS / 10));
+    return EXIT_SUCCESS;
+}
+
+static void run_blocks(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            THROW(OOPS, NULL);
+        } CATCH (OOPS) {
+            counter++;
+        }
+    }
+}
+
+static void run_snapshots(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        counter += e4c_get_statistics().exceptions;
+    }
+}
+
+static void run_scans(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        counter += e4c_watchdog_scan(0, report, NULL);
+    }
+}
+
+static void report(const struct e4c_context * context, const struct e4c_block_snapshot * block, void * argument) {
+    (void) context;
+    (void) block;
+    (void) argument;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+#define EVENT_LOOP_ITERATIONS 100000
+
+struct request {
+    uint64_t value;
+    int error;
+    struct e4c_operation operation;
+};
+
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+static volatile int counter = 0;
+static int epoll = -1;
+static int event = -1;
+static int failure_rate = 0;
+
+static void run_plain(int);
+static void run_adapter(int);
+static void dispatch(void (*)(struct request *), void (*)(struct request *), int);
+static void complete_plain(struct request *);
+static void continue_plain(struct request *);
+static void complete_adapter(struct request *);
+static void continue_adapter(struct request *);
+static void report(const char *, void (*)(int), int);
+
+/**
+ * Measures the per-operation overhead of delivering exceptions across an epoll event loop.
+ */
+int main(void) {
+    struct epoll_event readable = {.events = EPOLLIN};
+    epoll = epoll_create1(0);
+    event = eventfd(0, EFD_NONBLOCK);
+    if (epoll < 0 || event < 0 || epoll_ctl(epoll, EPOLL_CTL_ADD, event, &readable) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    BENCHMARK_TITLE("Event loop: cost per operation (eventfd + epoll)");
+    BENCHMARK_PRINT("%-40s %12s\n", "continuation", "ns/op");
+    report("error code (no adapter)", run_plain, 0);
+    report("adapter, no failures", run_adapter, 0);
+    report("adapter, 1% failures", run_adapter, 100);
+    report("adapter, all failures", run_adapter, 1);
+    return EXIT_SUCCESS;
+}
+
+static void report(const char * name, void (*run)(int), const int rate) {
+    failure_rate = rate;
+    BENCHMARK_PRINT("%-40s %12.1f\n", name, benchmark_time(run, EVENT_LOOP_ITERATIONS));
+}
+
+static void run_plain(const int iterations) {
+    dispatch(complete_plain, continue_plain, iterations);
+}
+
+static void run_adapter(const int iterations) {
+    dispatch(complete_adapter, continue_adapter, iterations);
+}
+
+/* Issues one operation at a time, and runs its callback and continuation when it completes */
+static void dispatch(void (*complete)(struct request *), void (*resume)(struct request *), const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        struct request request = {.value = (uint64_t) iteration + 1};
+        struct epoll_event events[1];
+        if (write(event, &request.value, sizeof(request.value)) != sizeof(request.value)
+            || epoll_wait(epoll, events, 1, -1) != 1) {
+            exit(EXIT_FAILURE);
+        }
+        complete(&request);
+        resume(&request);
+    }
+}
+
+static void complete_plain(struct request * request) {
+    if (read(event, &request->value, sizeof(request->value)) != sizeof(request->value)) {
+        request->error = -1;
+    }
+}
+
+static void continue_plain(struct request * request) {
+    counter += request->error == 0 ? 1 : -1;
+}
+
+static void complete_adapter(struct request * request) {
+    TRY {
+        if (read(event, &request->value, sizeof(request->value)) != sizeof(request->value)
+            || (failure_rate > 0 && request->value % failure_rate == 0)) {
+            THROW(OOPS, "Operation %d failed", (int) request->value);
+        }
+    } CATCH_ALL {
+        (void) e4c_operation_fail(&request->operation);
+    }
+}
+
+static void continue_adapter(struct request * request) {
+    TRY {
+        THROW_IF_FAILED(&request->operation);
+        counter++;
+    } CATCH (OOPS) {
+        counter--;
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+#if EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_SETJMP
+#define BACKEND_NAME "setjmp"
+#elif EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_SIGSETJMP
+#define BACKEND_NAME "sigsetjmp"
+#elif EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_BUILTIN
+#define BACKEND_NAME "__builtin_setjmp"
+#elif EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_UCONTEXT
+#define BACKEND_NAME "ucontext"
+#else
+#define BACKEND_NAME "custom"
+#endif
+
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+static volatile int counter = 0;
+
+static void run_try(int);
+static void run_throw(int);
+
+/**
+ * Measures the cost of exception blocks with the selected non-local jump backend.
+ */
+int main(void) {
+    BENCHMARK_TITLE("Jump backend: " BACKEND_NAME);
+    BENCHMARK_PRINT("%-40s %12s\n", "scenario", "ns/block");
+    BENCHMARK_PRINT("%-40s %12.1f\n", "TRY", benchmark_time(run_try, BENCHMARK_ITERATIONS));
+    BENCHMARK_PRINT("%-40s %12.1f\n", "TRY + THROW + CATCH", benchmark_time(run_throw, BENCHMARK_ITERATIONS));
+    return EXIT_SUCCESS;
+}
+
+static void run_try(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            counter++;
+        } CATCH (OOPS) {
+            counter--;
+        }
+    }
+}
+
+static void run_throw(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            THROW(OOPS, NULL);
+        } CATCH (OOPS) {
+            counter++;
+        }
+    }
+}
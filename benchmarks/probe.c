@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+static volatile char region[64];
+static volatile int counter = 0;
+
+static void run_plain(int);
+static void run_probe(int);
+static void run_try(int);
+static void report(const char *, void (*)(int));
+
+/**
+ * Compares the cost of guarding a memory access with a PROBE block against a TRY block.
+ */
+int main(void) {
+    BENCHMARK_TITLE("Probe: cost per guarded access");
+    BENCHMARK_PRINT("%-40s %12s\n", "guard", "ns/access");
+    report("none", run_plain);
+    report("PROBE", run_probe);
+    report("TRY", run_try);
+    return EXIT_SUCCESS;
+}
+
+static void report(const char * name, void (*run)(int)) {
+    BENCHMARK_PRINT("%-40s %12.1f\n", name, benchmark_time(run, BENCHMARK_ITERATIONS));
+}
+
+static void run_plain(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        counter += region[iteration % sizeof(region)];
+    }
+}
+
+static void run_probe(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        PROBE (region, sizeof(region)) {
+            counter += region[iteration % sizeof(region)];
+        }
+    }
+}
+
+static void run_try(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            counter += region[iteration % sizeof(region)];
+        } CATCH (OOPS) {
+            counter--;
+        }
+    }
+}
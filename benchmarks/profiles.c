@@ -0,0 +1,64 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* the library is included so that the size of the internal exception block can be measured */
+#include "exceptions4c.c"
+#include "benchmark.h"
+
+#ifndef PROFILE_NAME
+#define PROFILE_NAME "default"
+#endif
+
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+static volatile int counter = 0;
+
+static void run_try(int);
+static void run_throw(int);
+
+/**
+ * Measures the size of the data structures and the cost of exception blocks with the selected feature profile.
+ */
+int main(void) {
+    BENCHMARK_TITLE("Feature profile: " PROFILE_NAME);
+    BENCHMARK_PRINT("%-40s %12s\n", "measure", "value");
+    BENCHMARK_PRINT("%-40s %12d\n", "sizeof(struct e4c_block)", (int) sizeof(struct e4c_block));
+    BENCHMARK_PRINT("%-40s %12d\n", "sizeof(struct e4c_exception)", (int) sizeof(struct e4c_exception));
+    BENCHMARK_PRINT("%-40s %12d\n", "sizeof(struct e4c_context)", (int) sizeof(struct e4c_context));
+    BENCHMARK_PRINT("%-40s %12.1f\n", "TRY (ns/block)", benchmark_time(run_try, BENCHMARK_ITERATIONS));
+    BENCHMARK_PRINT("%-40s %12.1f\n", "TRY + THROW + CATCH (ns/block)", benchmark_time(run_throw, BENCHMARK_ITERATIONS));
+    return EXIT_SUCCESS;
+}
+
+static void run_try(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            counter++;
+        } CATCH (OOPS) {
+            counter--;
+        }
+    }
+}
+
+static void run_throw(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            THROW(OOPS, NULL);
+        } CATCH (OOPS) {
+            counter++;
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+#define RETRY_ITERATIONS 100000
+#define RETRY_ATTEMPTS 3
+
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+static void skip_sleep(long);
+
+static const struct e4c_backoff exponential = {.strategy = E4C_BACKOFF_EXPONENTIAL, .initial_delay = 10, .sleep = skip_sleep};
+static const struct e4c_backoff jitter = {.strategy = E4C_BACKOFF_DECORRELATED_JITTER, .initial_delay = 10, .max_delay = 1000, .sleep = skip_sleep};
+static const struct e4c_backoff budget = {.strategy = E4C_BACKOFF_EXPONENTIAL, .initial_delay = 10, .budget = 60000, .sleep = skip_sleep};
+
+static volatile int counter = 0;
+
+static void run_retry(int);
+static void run_retry_exponential(int);
+static void run_retry_jitter(int);
+static void run_retry_budget(int);
+static void report(const char *, void (*)(int));
+
+/**
+ * Compares the bookkeeping cost of RETRY_BACKOFF against RETRY, without actually waiting.
+ */
+int main(void) {
+    BENCHMARK_TITLE("Backoff: cost per block retried three times, without waiting");
+    BENCHMARK_PRINT("%-40s %12s\n", "retry", "ns/block");
+    report("RETRY", run_retry);
+    report("RETRY_BACKOFF (exponential)", run_retry_exponential);
+    report("RETRY_BACKOFF (decorrelated jitter)", run_retry_jitter);
+    report("RETRY_BACKOFF (exponential, budget)", run_retry_budget);
+    return EXIT_SUCCESS;
+}
+
+static void report(const char * name, void (*run)(int)) {
+    BENCHMARK_PRINT("%-40s %12.1f\n", name, benchmark_time(run, RETRY_ITERATIONS));
+}
+
+static void skip_sleep(const long milliseconds) {
+    counter += (int) (milliseconds & 1);
+}
+
+static void run_retry(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        volatile int attempts = 0;
+        TRY {
+            if (attempts++ < RETRY_ATTEMPTS) {
+                THROW(OOPS, NULL);
+            }
+        } CATCH (OOPS) {
+            RETRY(RETRY_ATTEMPTS, OOPS, NULL);
+        }
+    }
+}
+
+static void run_retry_exponential(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        volatile int attempts = 0;
+        TRY {
+            if (attempts++ < RETRY_ATTEMPTS) {
+                THROW(OOPS, NULL);
+            }
+        } CATCH (OOPS) {
+            RETRY_BACKOFF(RETRY_ATTEMPTS, exponential, OOPS, NULL);
+        }
+    }
+}
+
+static void run_retry_jitter(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        volatile int attempts = 0;
+        TRY {
+            if (attempts++ < RETRY_ATTEMPTS) {
+                THROW(OOPS, NULL);
+            }
+        } CATCH (OOPS) {
+            RETRY_BACKOFF(RETRY_ATTEMPTS, jitter, OOPS, NULL);
+        }
+    }
+}
+
+static void run_retry_budget(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        volatile int attempts = 0;
+        TRY {
+            if (attempts++ < RETRY_ATTEMPTS) {
+                THROW(OOPS, NULL);
+            }
+        } CATCH (OOPS) {
+            RETRY_BACKOFF(RETRY_ATTEMPTS, budget, OOPS, NULL);
+        }
+    }
+}
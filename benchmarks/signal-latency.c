@@ -0,0 +1,83 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+#define SIGNAL_ITERATIONS 100000
+
+static const struct e4c_exception_type INTERRUPTED = {NULL, "Interrupted"};
+
+static volatile int counter = 0;
+static volatile int * volatile null_pointer = NULL;
+
+static void run_throw(int);
+static void run_raise(int);
+static void run_fault(int);
+static void report(const char *, void (*)(int));
+
+/**
+ * Measures the latency from a signal to the #CATCH block that handles it.
+ */
+int main(void) {
+    static const struct e4c_signal_mapping mappings[] = {
+        SIGNAL_MAPPING(SIGUSR1, INTERRUPTED)
+    };
+    if (!e4c_map_signals(NULL, 0) || !e4c_map_signals(mappings, 1)) {
+        return EXIT_FAILURE;
+    }
+
+    BENCHMARK_TITLE("Signal mapping: latency from signal to CATCH");
+    BENCHMARK_PRINT("%-40s %12s\n", "source", "ns/signal");
+    report("THROW (no signal)", run_throw);
+    report("raise(SIGUSR1)", run_raise);
+    report("null pointer dereference (SIGSEGV)", run_fault);
+    return EXIT_SUCCESS;
+}
+
+static void report(const char * name, void (*run)(int)) {
+    BENCHMARK_PRINT("%-40s %12.1f\n", name, benchmark_time(run, SIGNAL_ITERATIONS));
+}
+
+static void run_throw(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY_SIGNALSAFE {
+            THROW(INTERRUPTED, NULL);
+        } CATCH (INTERRUPTED) {
+            counter++;
+        }
+    }
+}
+
+static void run_raise(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY_SIGNALSAFE {
+            (void) raise(SIGUSR1);
+        } CATCH (INTERRUPTED) {
+            counter++;
+        }
+    }
+}
+
+static void run_fault(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY_SIGNALSAFE {
+            *null_pointer = iteration;
+        } CATCH (SEGMENTATION_FAULT) {
+            counter++;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdatomic.h>
+#include <exceptions4c-parallel.h>
+#include "benchmark.h"
+
+#define TASKS 10000
+#define DEPENDENCIES 3
+#define WINDOW 64
+#define THREADS 4
+#define WORK 2000
+
+static void run(void *);
+static atomic_int runs = 0;
+static int failure_rate = 0;
+static int ids[TASKS];
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Measures the cost of running a large task graph, depending on the number of injected failures.
+ */
+int main(void) {
+    static const int rates[] = {0, 1, 10, 100};
+    e4c_set_context_supplier(e4c_thread_context);
+
+    /* every task depends on a few of the previous ones */
+    struct e4c_task_graph * graph = e4c_task_graph_create();
+    unsigned int seed = 12345;
+    for (int id = 0; id < TASKS; id++) {
+        ids[id] = id;
+        (void) e4c_task_graph_add(graph, run, &ids[id]);
+        for (int dependency = 0; dependency < DEPENDENCIES && id > 0; dependency++) {
+            seed = seed * 1103515245 + 12345;
+            const int window = id < WINDOW ? id : WINDOW;
+            e4c_task_graph_depend(graph, id, id - 1 - (int) ((seed >> 16) % (unsigned int) window));
+        }
+    }
+
+    BENCHMARK_TITLE("Task graph: 10000 tasks, 4 threads");
+    BENCHMARK_PRINT("%-40s %12s %12s %12s\n", "injected failures (per 10000)", "run", "failed", "time (ms)");
+    for (size_t index = 0; index < sizeof(rates) / sizeof(rates[0]); index++) {
+        failure_rate = rates[index];
+        atomic_store(&runs, 0);
+        const double start = benchmark_now();
+        const int failed = e4c_task_graph_run(graph, THREADS);
+        const double time = (benchmark_now() - start) / 1e6;
+        BENCHMARK_PRINT("%-40d %12d %12d %12.1f\n", failure_rate, atomic_load(&runs), failed, time);
+    }
+    e4c_task_graph_delete(graph);
+    return EXIT_SUCCESS;
+}
+
+static void run(void * argument) {
+    const int id = *(const int *) argument;
+    atomic_fetch_add(&runs, 1);
+    for (volatile int work = 0; work < WORK; work++) {
+        /* simulate some work */
+    }
+    /* failures are spread evenly across the graph */
+    if (failure_rate > 0 && id % (TASKS / failure_rate) == TASKS / failure_rate / 2) {
+        THROW(OOPS, "Task %d failed", id);
+    }
+}
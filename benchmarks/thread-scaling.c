@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+#define MAX_THREADS 8
+
+static pthread_key_t key;
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+static volatile int counter = 0;
+
+static struct e4c_context * keyed_context(void);
+static double throughput(int);
+static void * run_thread(void *);
+
+/**
+ * Measures the throughput of TRY/THROW/CATCH blocks in concurrent threads,
+ * depending on how each thread gets its exception context.
+ */
+int main(void) {
+    (void) pthread_key_create(&key, free);
+    BENCHMARK_TITLE("TRY/THROW/CATCH: throughput across threads");
+    BENCHMARK_PRINT("%-40s %12s %12s\n", "threads", "keyed (M/s)", "local (M/s)");
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        e4c_set_context_supplier(keyed_context);
+        const double keyed = throughput(threads);
+        e4c_set_context_supplier(e4c_thread_context);
+        const double local = throughput(threads);
+        BENCHMARK_PRINT("%-40d %12.2f %12.2f\n", threads, keyed, local);
+    }
+    return EXIT_SUCCESS;
+}
+
+/* a typical supplier that keeps one context per thread in thread-specific data */
+static struct e4c_context * keyed_context(void) {
+    struct e4c_context * context = pthread_getspecific(key);
+    if (context == NULL) {
+        context = calloc(1, sizeof(*context));
+        (void) pthread_setspecific(key, context);
+    }
+    return context;
+}
+
+static double throughput(const int threads) {
+    pthread_t thread[MAX_THREADS];
+    const double start = benchmark_now();
+    for (int index = 0; index < threads; index++) {
+        (void) pthread_create(&thread[index], NULL, run_thread, NULL);
+    }
+    for (int index = 0; index < threads; index++) {
+        (void) pthread_join(thread[index], NULL);
+    }
+    return (double) threads * BENCHMARK_ITERATIONS / (benchmark_now() - start) * 1e3;
+}
+
+static void * run_thread(void * _) {
+    (void) _;
+    for (int iteration = 0; iteration < BENCHMARK_ITERATIONS; iteration++) {
+        TRY {
+            THROW(OOPS, NULL);
+        } CATCH (OOPS) {
+            counter++;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+static volatile int counter = 0;
+
+static void run_try(int);
+static void run_try_signalsafe(int);
+static void report(const char *, void (*)(int));
+
+/**
+ * Compares the cost of blocks that save the signal mask against blocks that don't.
+ */
+int main(void) {
+    BENCHMARK_TITLE("Signal mask: cost per block entry");
+    BENCHMARK_PRINT("%-40s %12s %14s\n", "block", "ns/block", "syscalls/block");
+    report("TRY_SIGNALSAFE (same as TRY before)", run_try_signalsafe);
+    report("TRY", run_try);
+    return EXIT_SUCCESS;
+}
+
+static void report(const char * name, void (*run)(int)) {
+    const double nanoseconds = benchmark_time(run, BENCHMARK_ITERATIONS);
+    const double syscalls = benchmark_syscalls(run, BENCHMARK_SYSCALL_ITERATIONS);
+    if (syscalls < 0) {
+        BENCHMARK_PRINT("%-40s %12.1f %14s\n", name, nanoseconds, "n/a");
+    } else {
+        BENCHMARK_PRINT("%-40s %12.1f %14.2f\n", name, nanoseconds, syscalls);
+    }
+}
+
+static void run_try(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            counter++;
+        } CATCH (OOPS) {
+            counter--;
+        }
+    }
+}
+
+static void run_try_signalsafe(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY_SIGNALSAFE {
+            counter++;
+        } CATCH (OOPS) {
+            counter--;
+        }
+    }
+}
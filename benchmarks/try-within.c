@@ -0,0 +1,71 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "benchmark.h"
+
+#define DEADLINE_ITERATIONS 100000
+
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+static volatile int counter = 0;
+
+static void run_try(int);
+static void run_try_within(int);
+static void run_try_within_nested(int);
+static void report(const char *, void (*)(int));
+
+/**
+ * Compares the cost of a TRY_WITHIN block that finishes in time against a TRY block.
+ */
+int main(void) {
+    BENCHMARK_TITLE("Deadlines: cost per block that finishes in time");
+    BENCHMARK_PRINT("%-40s %12s\n", "block", "ns/block");
+    report("TRY", run_try);
+    report("TRY_WITHIN", run_try_within);
+    report("TRY_WITHIN (inside a TRY_WITHIN)", run_try_within_nested);
+    return EXIT_SUCCESS;
+}
+
+static void report(const char * name, void (*run)(int)) {
+    BENCHMARK_PRINT("%-40s %12.1f\n", name, benchmark_time(run, DEADLINE_ITERATIONS));
+}
+
+static void run_try(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY {
+            counter++;
+        } CATCH (OOPS) {
+            counter--;
+        }
+    }
+}
+
+static void run_try_within(const int iterations) {
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TRY_WITHIN(1000) {
+            counter++;
+        } CATCH (DEADLINE_EXCEEDED) {
+            counter--;
+        }
+    }
+}
+
+static void run_try_within_nested(const int iterations) {
+    TRY_WITHIN(60000) {
+        run_try_within(iterations);
+    }
+}
@@ -20,7 +20,7 @@
 
 #define main main_initialize_exception
 //! [initialize_exception]
-const struct e4c_exception_type PET_ERROR = {NULL, "Pet error"};
+const struct e4c_exception_type PET_ERROR = {.supertype = NULL, .default_message = "Pet error"};
 
 static void set_custom_data(struct e4c_exception * exception) {
   exception->data = "My custom data";
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! [reactor]
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <exceptions4c.h>
+
+#define CONNECTIONS 4
+
+const struct e4c_exception_type BAD_REQUEST = {.supertype = NULL, .default_message = "Bad request"};
+
+/* A pending request, along with its continuation */
+struct request {
+    int fd;
+    uint64_t value;
+    struct e4c_operation operation;
+    void (*continuation)(struct request * request);
+};
+
+/* Runs when the event loop detects that the request can be read */
+static void on_readable(struct request * request) {
+    TRY {
+        if (read(request->fd, &request->value, sizeof(request->value)) != sizeof(request->value)) {
+            THROW(BAD_REQUEST, "Could not read request");
+        }
+        if (request->value % 2 == 0) {
+            THROW(BAD_REQUEST, "Request %d is invalid", (int) request->value);
+        }
+    } CATCH_ALL {
+        /* the code waiting for the request is not on the stack: record the failure */
+        (void) e4c_operation_fail(&request->operation);
+    }
+    request->continuation(request);
+}
+
+/* Runs after the request was read, whether it succeeded or not */
+static void respond(struct request * request) {
+    TRY {
+        THROW_IF_FAILED(&request->operation);
+        printf("Request %d: OK\n", (int) request->value);
+    } CATCH (BAD_REQUEST) {
+        printf("Request failed: %s\n", e4c_get_exception()->message);
+    }
+}
+
+int main(void) {
+    struct request requests[CONNECTIONS] = {0};
+    const int epoll = epoll_create1(0);
+    if (epoll < 0) {
+        return EXIT_FAILURE;
+    }
+
+    for (int index = 0; index < CONNECTIONS; index++) {
+        const uint64_t value = index + 1;
+        struct epoll_event event = {.events = EPOLLIN, .data.ptr = &requests[index]};
+        requests[index].fd = eventfd(0, EFD_NONBLOCK);
+        requests[index].continuation = respond;
+        if (requests[index].fd < 0
+            || epoll_ctl(epoll, EPOLL_CTL_ADD, requests[index].fd, &event) != 0
+            /* simulate a client sending a request */
+            || write(requests[index].fd, &value, sizeof(value)) != sizeof(value)) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Event loop */
+    for (int pending = CONNECTIONS; pending > 0;) {
+        struct epoll_event events[CONNECTIONS];
+        const int ready = epoll_wait(epoll, events, CONNECTIONS, 1000);
+        if (ready <= 0) {
+            return EXIT_FAILURE;
+        }
+        for (int index = 0; index < ready; index++, pending--) {
+            on_readable(events[index].data.ptr);
+        }
+    }
+
+    for (int index = 0; index < CONNECTIONS; index++) {
+        (void) close(requests[index].fd);
+    }
+    (void) close(epoll);
+    return EXIT_SUCCESS;
+}
+//! [reactor]
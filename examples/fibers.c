@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//! [scheduler]
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+#include <exceptions4c.h>
+
+#define FIBERS 3
+#define STACK_SIZE 65536
+
+const struct e4c_exception_type ORDER_ERROR = {.supertype = NULL, .default_message = "Order error"};
+
+/* A fiber owns its own exception context */
+struct fiber {
+    ucontext_t ucontext;
+    struct e4c_context context;
+    char stack[STACK_SIZE];
+    bool done;
+};
+
+static struct fiber fibers[FIBERS];
+static struct fiber * current = NULL;
+static ucontext_t scheduler;
+
+/* Gives control back to the scheduler */
+static void yield(void) {
+    swapcontext(&current->ucontext, &scheduler);
+}
+
+/* Activates the exception context of a fiber, and resumes it until it yields */
+static void resume(struct fiber * fiber) {
+    struct e4c_context * previous = e4c_switch_context(&fiber->context);
+    current = fiber;
+    swapcontext(&scheduler, &fiber->ucontext);
+    current = NULL;
+    e4c_switch_context(previous);
+}
+
+static void process_order(int id) {
+    TRY {
+        printf("Fiber %d: processing order\n", id);
+        yield();
+        if (id % 2 == 0) {
+            THROW(ORDER_ERROR, "Order %d is invalid", id);
+        }
+        yield();
+        printf("Fiber %d: order processed\n", id);
+    } CATCH (ORDER_ERROR) {
+        /* other fibers may throw their own exceptions while this one waits */
+        yield();
+        printf("Fiber %d: %s\n", id, e4c_get_exception()->message);
+    }
+    fibers[id].done = true;
+}
+
+int main(void) {
+    for (int id = 0; id < FIBERS; id++) {
+        getcontext(&fibers[id].ucontext);
+        fibers[id].ucontext.uc_stack.ss_sp = fibers[id].stack;
+        fibers[id].ucontext.uc_stack.ss_size = STACK_SIZE;
+        fibers[id].ucontext.uc_link = &scheduler;
+        makecontext(&fibers[id].ucontext, (void (*)(void)) process_order, 1, id);
+    }
+
+    /* Round-robin scheduler */
+    for (bool pending = true; pending;) {
+        pending = false;
+        for (int id = 0; id < FIBERS; id++) {
+            if (!fibers[id].done) {
+                resume(&fibers[id]);
+                pending = true;
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+//! [scheduler]
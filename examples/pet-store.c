@@ -22,14 +22,14 @@ typedef struct pet { int id; const char * name; pet_status status; } * Pet;
 
 //! [exception_types]
 /* Generic errors */
-const struct e4c_exception_type NOT_ENOUGH_MEMORY = {NULL, "Not enough memory"};
+const struct e4c_exception_type NOT_ENOUGH_MEMORY = {.supertype = NULL, .default_message = "Not enough memory"};
 
 /* Base exception for all pet-related errors */
-const struct e4c_exception_type PET_ERROR = {NULL, "Pet error"};
+const struct e4c_exception_type PET_ERROR = {.supertype = NULL, .default_message = "Pet error"};
 
 /* Specific types of pet errors */
-const struct e4c_exception_type PET_NOT_FOUND = {&PET_ERROR, "Pet not found"};
-const struct e4c_exception_type PET_STORE_CLOSED = {&PET_ERROR, "Pet store closed"};
+const struct e4c_exception_type PET_NOT_FOUND = {.supertype = &PET_ERROR, .default_message = "Pet not found"};
+const struct e4c_exception_type PET_STORE_CLOSED = {.supertype = &PET_ERROR, .default_message = "Pet store closed"};
 //! [exception_types]
 
 // Available pets in the store
@@ -22,20 +22,8 @@ static void cancel_current_thread() {
     pthread_exit(PTHREAD_CANCELED);
 }
 
-struct e4c_context dummy = {
-    ._innermost_block = NULL,
-    .uncaught_handler = NULL,
-    .termination_handler = cancel_current_thread,
-    .initialize_exception = NULL,
-    .finalize_exception = NULL
-};
-
-struct e4c_context * e4c_pthreads_context_supplier() {
-    return &dummy;
-}
-
 //! [setup]
-const struct e4c_exception_type OOPS = {NULL, "Oops"};
+const struct e4c_exception_type OOPS = {.supertype = NULL, .default_message = "Oops"};
 
 /* A Thread that throws an exception */
 static void * my_thread(void * _) {
@@ -43,8 +31,11 @@ static void * my_thread(void * _) {
 }
 
 int main(void) {
-    /* Set the thread-safe exception context supplier */
-    e4c_set_context_supplier(&e4c_pthreads_context_supplier);
+    /* Uncaught exceptions will cancel the thread instead of terminating the program */
+    e4c_get_context()->termination_handler = cancel_current_thread;
+
+    /* Give each thread its own exception context */
+    e4c_set_context_supplier(e4c_thread_context);
 
     /* Start the thread */
     pthread_t thread;
@@ -19,11 +19,11 @@
 #include <signal.h>
 #include <exceptions4c.h>
 
-const struct e4c_exception_type SEGFAULT = {NULL, "Segmentation fault"};
+const struct e4c_exception_type SEGFAULT = {.supertype = NULL, .default_message = "Segmentation fault"};
 
 void segfault(int _) {
   signal(SIGSEGV, segfault);
-  THROW(SEGFAULT, NULL);
+  THROW_FROM_SIGNAL(SEGFAULT, NULL);
 }
 
 int main(void) {
@@ -31,7 +31,7 @@ int main(void) {
 
   signal(SIGSEGV, segfault);
 
-  TRY {
+  TRY_SIGNALSAFE {
     printf("Oh no %d", *null_pointer);
   } CATCH (SEGFAULT) {
     printf("Danger avoided!\n");
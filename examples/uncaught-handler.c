@@ -18,7 +18,7 @@
 #include <signal.h>
 #include <exceptions4c.h>
 
-const struct e4c_exception_type MY_ERROR = {NULL, "My error"};
+const struct e4c_exception_type MY_ERROR = {.supertype = NULL, .default_message = "My error"};
 
 //! [uncaught_handler]
 static void my_uncaught_handler(const struct e4c_exception * exception) {
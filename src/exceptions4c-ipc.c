@@ -0,0 +1,414 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Implementation of cross-process exception transport built on exceptions4c.
+ *
+ * <img src="exceptions4c-logo.svg">
+ *
+ * @file        exceptions4c-ipc.c
+ * @version     4.0.0
+ * @author      [Guillermo Calvo](https://guillermo.dev)
+ * @copyright   Licensed under Apache 2.0
+ * @see         For more information, visit the
+ *              [project on GitHub](https://github.com/guillermocalvo/exceptions4c)
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <exceptions4c-ipc.h>
+
+#ifndef EXCEPTIONS4C_RING_SLOT_SIZE
+/** @internal The number of bytes each exception record can take. */
+#define EXCEPTIONS4C_RING_SLOT_SIZE 2048
+#endif
+
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2, "Shared memory requires lock-free atomic integers");
+
+const struct e4c_exception_type IPC_ERROR = {.supertype = NULL, .default_message = "IPC error"};
+
+const struct e4c_exception_type REMOTE_ERROR = {.supertype = NULL, .default_message = "Remote error"};
+
+/**
+ * @internal
+ * @brief Represents the fixed-size part of an encoded exception.
+ *
+ * It is followed by the name, message, file, and function of the exception,
+ * as null-terminated strings.
+ */
+struct record_entry {
+
+    /** @internal The line number of the exception. */
+    int line;
+
+    /** @internal The error number of the exception. */
+    int error_number;
+};
+
+/**
+ * @internal
+ * @brief Represents a slot of a ring buffer.
+ */
+struct slot {
+
+    /** @internal The position of the record this slot is ready to be written or read at. */
+    atomic_uint sequence;
+
+    /** @internal The process ID of the writer, stored as soon as it claims the slot; zero while the slot is free. */
+    atomic_int pid;
+
+    /** @internal The number of encoded exceptions. */
+    int count;
+
+    /** @internal The number of encoded bytes. */
+    int size;
+
+    /** @internal The encoded exceptions. */
+    unsigned char data[EXCEPTIONS4C_RING_SLOT_SIZE];
+};
+
+/**
+ * @internal
+ * @brief Represents a ring buffer of exception records in shared memory.
+ */
+struct e4c_ring {
+
+    /** @internal The position of the next record to write. */
+    atomic_uint head;
+
+    /** @internal The position of the next record to read. */
+    atomic_uint tail;
+
+    /** @internal The number of slots. */
+    unsigned int capacity;
+
+    /** @internal The number of bytes mapped. */
+    size_t size;
+
+    /** @internal The slots. */
+    struct slot slots[];
+};
+
+/** The ring uncaught exceptions are written to. */
+static struct e4c_ring * installed_ring = NULL;
+
+static void write_uncaught(const struct e4c_exception * exception);
+static size_t encode(unsigned char * data, const struct e4c_exception * exception, int * count);
+static size_t encode_string(unsigned char * data, size_t offset, size_t limit, const char * string);
+static struct e4c_exception * decode(const struct slot * slot, const struct e4c_exception_type * (*resolve)(const char * name));
+static const char * decode_string(const unsigned char * data, size_t * offset, size_t size);
+static bool is_abandoned(const struct e4c_ring * ring, const struct slot * slot, unsigned int position);
+static void release(struct e4c_ring * ring, struct slot * slot, unsigned int position);
+static void copy(void * destination, const void * source, size_t size);
+
+struct e4c_ring * e4c_ring_create(const int capacity) {
+    if (capacity <= 0) {
+        THROW(IPC_ERROR, "Invalid ring capacity: %d", capacity);
+    }
+    const size_t size = sizeof(struct e4c_ring) + (size_t) capacity * sizeof(struct slot);
+#ifdef MFD_CLOEXEC
+    const int fd = memfd_create("exceptions4c", MFD_CLOEXEC);
+    if (fd < 0) {
+        THROW(IPC_ERROR, "Shared memory could not be created");
+    }
+    void * memory = ftruncate(fd, (off_t) size) == 0 ? mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    (void) close(fd);
+#else
+    /* memory files are not available; anonymous shared memory is inherited by forked processes as well */
+    void * memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+#endif
+    if (memory == MAP_FAILED) {
+        THROW(IPC_ERROR, "Shared memory could not be mapped");
+    }
+    struct e4c_ring * ring = memory;
+    ring->capacity = (unsigned int) capacity;
+    ring->size = size;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    for (unsigned int position = 0; position < ring->capacity; position++) {
+        atomic_init(&ring->slots[position].sequence, position);
+        atomic_init(&ring->slots[position].pid, 0);
+    }
+    return ring;
+}
+
+bool e4c_ring_write(struct e4c_ring * ring, const struct e4c_exception * exception) {
+    if (exception == NULL) {
+        return false;
+    }
+    /* claim a slot (bounded multi-producer queue) */
+    struct slot * slot;
+    unsigned int position = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    for (;;) {
+        slot = &ring->slots[position % ring->capacity];
+        const int distance = (int) (atomic_load_explicit(&slot->sequence, memory_order_acquire) - position);
+        if (distance < 0) {
+            /* the ring is full */
+            return false;
+        }
+        if (distance == 0 && atomic_compare_exchange_weak_explicit(&ring->head, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+        if (distance > 0) {
+            position = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        }
+    }
+    atomic_store_explicit(&slot->pid, (int) getpid(), memory_order_relaxed);
+    slot->size = (int) encode(slot->data, exception, &slot->count);
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+    return true;
+}
+
+void e4c_ring_install(struct e4c_ring * ring) {
+    installed_ring = ring;
+    e4c_get_context()->uncaught_handler = write_uncaught;
+}
+
+struct e4c_exception * e4c_ring_read(struct e4c_ring * ring, pid_t * pid, const struct e4c_exception_type * (*resolve)(const char * name)) {
+    for (;;) {
+        const unsigned int position = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        struct slot * slot = &ring->slots[position % ring->capacity];
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != position + 1) {
+            if (!is_abandoned(ring, slot, position)) {
+                return NULL;
+            }
+            /* the writer died before publishing its record, which would otherwise block the ring forever */
+            release(ring, slot, position);
+            continue;
+        }
+        struct e4c_exception * exceptions = decode(slot, resolve);
+        if (pid != NULL) {
+            *pid = (pid_t) atomic_load_explicit(&slot->pid, memory_order_relaxed);
+        }
+        release(ring, slot, position);
+        /* records that cannot be decoded are skipped */
+        if (exceptions != NULL) {
+            return exceptions;
+        }
+    }
+}
+
+void e4c_ring_delete(struct e4c_ring * ring) {
+    if (ring != NULL) {
+        (void) munmap(ring, ring->size);
+    }
+}
+
+/**
+ * Writes an uncaught exception to the installed ring.
+ *
+ * @param exception the uncaught exception.
+ */
+static void write_uncaught(const struct e4c_exception * exception) {
+    if (installed_ring != NULL) {
+        (void) e4c_ring_write(installed_ring, exception);
+    }
+}
+
+/**
+ * Encodes an exception and its causes, as many as they fit in a slot.
+ *
+ * @param data the buffer to encode the exceptions into.
+ * @param exception the exception to encode.
+ * @param count a pointer that receives the number of encoded exceptions.
+ * @return the number of encoded bytes.
+ */
+static size_t encode(unsigned char * data, const struct e4c_exception * exception, int * count) {
+    /* the smallest entry possible: four empty strings */
+    static const size_t minimum = sizeof(struct record_entry) + 4;
+    size_t offset = 0;
+    *count = 0;
+    for (; exception != NULL && offset + minimum <= EXCEPTIONS4C_RING_SLOT_SIZE; exception = exception->cause) {
+        struct record_entry entry = {0};
+        const char * file = NULL;
+        const char * function = NULL;
+#ifndef EXCEPTIONS4C_NO_DEBUG_INFO
+        entry.line = exception->line;
+        file = exception->file;
+        function = exception->function;
+#endif
+#ifndef EXCEPTIONS4C_NO_ERRNO
+        entry.error_number = exception->error_number;
+#endif
+        copy(data + offset, &entry, sizeof(entry));
+        offset += sizeof(entry);
+        /* leave room for the null terminators of the remaining strings */
+        offset = encode_string(data, offset, EXCEPTIONS4C_RING_SLOT_SIZE - 3, exception->name);
+        offset = encode_string(data, offset, EXCEPTIONS4C_RING_SLOT_SIZE - 2, exception->message);
+        offset = encode_string(data, offset, EXCEPTIONS4C_RING_SLOT_SIZE - 1, file);
+        offset = encode_string(data, offset, EXCEPTIONS4C_RING_SLOT_SIZE, function);
+        (*count)++;
+    }
+    return offset;
+}
+
+/**
+ * Encodes a null-terminated string, truncating it if it does not fit.
+ *
+ * @param data the buffer to encode the string into.
+ * @param offset the offset to encode the string at; MUST be less than <tt>limit</tt>.
+ * @param limit the offset the encoded string must end before.
+ * @param string a possibly-null string.
+ * @return the offset right after the encoded string.
+ */
+static size_t encode_string(unsigned char * data, size_t offset, const size_t limit, const char * string) {
+    for (; string != NULL && *string != '\0' && offset + 1 < limit; string++, offset++) {
+        data[offset] = (unsigned char) *string;
+    }
+    data[offset] = '\0';
+    return offset + 1;
+}
+
+/**
+ * Decodes the exceptions of a slot, as many as can be decoded.
+ *
+ * @param slot the slot to decode.
+ * @param resolve a possibly-null function that maps exception names to exception types.
+ * @return the decoded exceptions, or <tt>NULL</tt> if none could be decoded.
+ */
+static struct e4c_exception * decode(const struct slot * slot, const struct e4c_exception_type * (*resolve)(const char * name)) {
+    /* the smallest entry possible: four empty strings */
+    static const size_t minimum = sizeof(struct record_entry) + 4;
+    /* the slot may have been left inconsistent by a faulty writer, so neither its size nor its count are trusted */
+    const int encoded_size = slot->size;
+    const int encoded_count = slot->count;
+    const size_t size = encoded_size < 0 ? 0 : encoded_size > EXCEPTIONS4C_RING_SLOT_SIZE ? EXCEPTIONS4C_RING_SLOT_SIZE : (size_t) encoded_size;
+    const int limit = (int) (size / minimum);
+    const int count = encoded_count < 0 ? 0 : encoded_count > limit ? limit : encoded_count;
+    if (count == 0) {
+        return NULL;
+    }
+
+    /* the exceptions are followed by a copy of the encoded data, which the strings point to */
+    struct e4c_exception * exceptions = malloc((size_t) count * sizeof(struct e4c_exception) + size);
+    if (exceptions == NULL) {
+        THROW(IPC_ERROR, "Not enough memory to read an exception");
+    }
+    unsigned char * data = (unsigned char *) &exceptions[count];
+    memcpy(data, slot->data, size);
+    size_t offset = 0;
+    int decoded = 0;
+    for (; decoded < count && offset + sizeof(struct record_entry) <= size; decoded++) {
+        struct e4c_exception * exception = &exceptions[decoded];
+        struct record_entry entry;
+        memcpy(&entry, data + offset, sizeof(entry));
+        offset += sizeof(entry);
+        const char * name = decode_string(data, &offset, size);
+        const char * message = decode_string(data, &offset, size);
+        const char * file = decode_string(data, &offset, size);
+        const char * function = decode_string(data, &offset, size);
+        if (function == NULL) {
+            break;
+        }
+        memset(exception, 0, sizeof(*exception));
+        exception->type = resolve != NULL ? resolve(name) : NULL;
+        if (exception->type == NULL) {
+            exception->type = &REMOTE_ERROR;
+        }
+        exception->name = name;
+        (void) strncpy(exception->message, message, sizeof(exception->message) - 1);
+#ifndef EXCEPTIONS4C_NO_DEBUG_INFO
+        exception->file = *file != '\0' ? file : NULL;
+        exception->line = entry.line;
+        exception->function = *function != '\0' ? function : NULL;
+#else
+        (void) file;
+#endif
+#ifndef EXCEPTIONS4C_NO_ERRNO
+        exception->error_number = entry.error_number;
+#endif
+        exception->_allocation = exceptions;
+        if (decoded > 0) {
+            exceptions[decoded - 1].cause = exception;
+        }
+    }
+    if (decoded == 0) {
+        free(exceptions);
+        return NULL;
+    }
+    return exceptions;
+}
+
+/**
+ * Decodes a null-terminated string, without reading past the encoded data.
+ *
+ * @param data the encoded data.
+ * @param offset a pointer to the offset of the string; it receives the offset right after the string.
+ * @param size the number of encoded bytes.
+ * @return the decoded string, or <tt>NULL</tt> if it is not null-terminated.
+ */
+static const char * decode_string(const unsigned char * data, size_t * offset, const size_t size) {
+    const unsigned char * terminator = *offset < size ? memchr(data + *offset, '\0', size - *offset) : NULL;
+    if (terminator == NULL) {
+        *offset = size;
+        return NULL;
+    }
+    const char * string = (const char *) data + *offset;
+    *offset = (size_t) (terminator - data) + 1;
+    return string;
+}
+
+/**
+ * Determines whether a slot was claimed by a writer that died before publishing its record.
+ *
+ * @param ring the ring the slot belongs to.
+ * @param slot the slot.
+ * @param position the position of the record the slot is expected to hold.
+ * @return <tt>true</tt> if the slot was abandoned; <tt>false</tt> otherwise.
+ */
+static bool is_abandoned(const struct e4c_ring * ring, const struct slot * slot, const unsigned int position) {
+    /* a slot that was not claimed yet is just empty */
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != position || (int) (atomic_load_explicit(&ring->head, memory_order_relaxed) - position) <= 0) {
+        return false;
+    }
+    const pid_t writer = (pid_t) atomic_load_explicit(&slot->pid, memory_order_relaxed);
+    return writer != 0 && kill(writer, 0) != 0 && errno == ESRCH;
+}
+
+/**
+ * Releases a slot for the next lap, and moves on to the next record.
+ *
+ * @param ring the ring the slot belongs to.
+ * @param slot the slot.
+ * @param position the position of the record the slot held.
+ */
+static void release(struct e4c_ring * ring, struct slot * slot, const unsigned int position) {
+    atomic_store_explicit(&slot->pid, 0, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, position + ring->capacity, memory_order_release);
+    atomic_store_explicit(&ring->tail, position + 1, memory_order_relaxed);
+}
+
+/**
+ * Copies bytes without calling any library function, so that it is async-signal-safe.
+ *
+ * @param destination the bytes to copy to.
+ * @param source the bytes to copy from.
+ * @param size the number of bytes to copy.
+ */
+static void copy(void * destination, const void * source, const size_t size) {
+    unsigned char * to = destination;
+    const unsigned char * from = source;
+    for (size_t index = 0; index < size; index++) {
+        to[index] = from[index];
+    }
+}
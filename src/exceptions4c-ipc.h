@@ -0,0 +1,178 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Cross-process exception transport built on exceptions4c.
+ *
+ * This module lets worker processes report exceptions to a supervisor
+ * process through a ring buffer in shared memory.
+ *
+ * ```c
+ * #include <exceptions4c-ipc.h>
+ * ```
+ *
+ * @file        exceptions4c-ipc.h
+ * @version     4.0.0
+ * @author      [Guillermo Calvo](https://guillermo.dev)
+ * @copyright   Licensed under Apache 2.0
+ * @see         For more information, visit the
+ *              [project on GitHub](https://github.com/guillermocalvo/exceptions4c)
+ */
+
+#ifndef EXCEPTIONS4C_IPC
+
+/**
+ * Returns the major version number of this module.
+ */
+#define EXCEPTIONS4C_IPC 4
+
+#include <sys/types.h>
+#include <exceptions4c.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Represents a failure to set up cross-process exception transport.
+ *
+ * @see e4c_ring_create
+ */
+extern const struct e4c_exception_type IPC_ERROR;
+
+/**
+ * Represents an exception read from another process whose type could not be
+ * resolved.
+ *
+ * The [name](#e4c_exception.name) of a #REMOTE_ERROR is the name of the
+ * original exception type.
+ *
+ * @see e4c_ring_read
+ */
+extern const struct e4c_exception_type REMOTE_ERROR;
+
+/**
+ * Represents a ring buffer of exception records in shared memory.
+ *
+ * Each record holds the name, message, and debug information of an
+ * exception and its causes, encoded in a fixed-size slot. Any number of
+ * processes can write records concurrently; only one process SHOULD read
+ * them.
+ *
+ * @see e4c_ring_create
+ */
+struct e4c_ring;
+
+/**
+ * Creates a ring buffer of exception records in shared memory.
+ *
+ * @param capacity the maximum number of records the ring can hold.
+ * @return a pointer to the new ring.
+ * @throws IPC_ERROR if the shared memory could not be created.
+ *
+ * The ring is backed by an anonymous memory file (or anonymous memory, if
+ * <tt>memfd_create</tt> is not available), mapped as shared memory. It
+ * SHOULD be created by the supervisor before forking the workers, so that
+ * they inherit the mapping.
+ *
+ * @see e4c_ring_delete
+ */
+struct e4c_ring * e4c_ring_create(int capacity);
+
+/**
+ * Writes an exception record to a ring buffer.
+ *
+ * @param ring the ring to write to.
+ * @param exception the exception to write, along with its causes.
+ * @return <tt>true</tt> if the record was written; <tt>false</tt> if the
+ *   ring was full, or the exception was <tt>NULL</tt>.
+ *
+ * Strings that do not fit in a slot are truncated, and the causes that do
+ * not fit are dropped.
+ *
+ * @note
+ * This function is lock-free and async-signal-safe. It never allocates
+ * memory and never waits for other processes, so it can be called in a
+ * crash path.
+ */
+bool e4c_ring_write(struct e4c_ring * ring, const struct e4c_exception * exception);
+
+/**
+ * Writes uncaught exceptions of the current exception context to a ring buffer.
+ *
+ * @param ring the ring to write uncaught exceptions to.
+ *
+ * This function sets the [uncaught handler](#e4c_context.uncaught_handler)
+ * of the current exception context, so that exceptions that reach the top
+ * level of the program are written to the ring, instead of being printed to
+ * the standard error output. Workers SHOULD call this function right after
+ * being forked.
+ *
+ * ```c
+ * if (fork() == 0) {
+ *     e4c_ring_install(ring);
+ *     run_worker();
+ * }
+ * ```
+ */
+void e4c_ring_install(struct e4c_ring * ring);
+
+/**
+ * Reads the oldest exception record from a ring buffer.
+ *
+ * @param ring the ring to read from.
+ * @param pid a possibly-null pointer that receives the process ID of the
+ *   writer.
+ * @param resolve a possibly-null function that maps exception names to
+ *   exception types.
+ * @return the decoded exception, along with its causes, or <tt>NULL</tt> if
+ *   the ring is empty.
+ *
+ * The decoded exception is allocated as a single block of memory, just like
+ * the exceptions captured via #e4c_capture. It MAY be passed to
+ * #THROW_CAPTURED, or deleted via <tt>free</tt>. Exceptions whose names are
+ * not resolved to a type are decoded as #REMOTE_ERROR.
+ *
+ * Records are validated before being decoded, so a writer that crashed in
+ * the middle of writing one cannot make this function read out of bounds;
+ * records that cannot be decoded at all are skipped. A record whose writer
+ * has exited (and been reaped) without finishing it is skipped too, so that
+ * it does not block the ring.
+ *
+ * @remark
+ * Only one thread SHOULD read from a ring at a time.
+ *
+ * @warning
+ * A writer that dies right after claiming a slot, before storing its
+ * process ID, cannot be told apart from a slow writer, so its slot blocks
+ * the ring. Process IDs reused by the system may delay skipping a slot too.
+ */
+struct e4c_exception * e4c_ring_read(struct e4c_ring * ring, pid_t * pid, const struct e4c_exception_type * (*resolve)(const char * name));
+
+/**
+ * Deletes a ring buffer.
+ *
+ * @param ring the ring to delete.
+ *
+ * The shared memory is unmapped from the current process only.
+ */
+void e4c_ring_delete(struct e4c_ring * ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
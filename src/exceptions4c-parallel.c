@@ -0,0 +1,1155 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * Implementation of parallel execution built on exceptions4c.
+ *
+ * <img src="exceptions4c-logo.svg">
+ *
+ * @file        exceptions4c-parallel.c
+ * @version     4.0.0
+ * @author      [Guillermo Calvo](https://guillermo.dev)
+ * @copyright   Licensed under Apache 2.0
+ * @see         For more information, visit the
+ *              [project on GitHub](https://github.com/guillermocalvo/exceptions4c)
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdnoreturn.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <exceptions4c-parallel.h>
+
+/** @internal The average number of chunks each worker gets. */
+#define CHUNKS_PER_WORKER 8
+
+const struct e4c_exception_type PARALLEL_ERROR = {.supertype = NULL, .default_message = "Parallel error"};
+
+const struct e4c_exception_type DEPENDENCY_ERROR = {.supertype = NULL, .default_message = "Dependency failed"};
+
+/**
+ * @internal
+ * @brief Represents the state of a task of a task graph.
+ */
+enum node_state {
+
+    /** @internal The task is waiting for its dependencies, or to be run. */
+    PENDING,
+
+    /** @internal The task is running. */
+    RUNNING,
+
+    /** @internal The task completed. */
+    COMPLETED,
+
+    /** @internal The task threw an exception. */
+    FAILED,
+
+    /** @internal One of the dependencies of the task failed. */
+    SKIPPED
+};
+
+/**
+ * @internal
+ * @brief Represents a task of a task graph.
+ */
+struct node {
+
+    /** The function to run. */
+    void (*function)(void * argument);
+
+    /** The argument to pass to the function. */
+    void * argument;
+
+    /** The identifiers of the tasks that depend on this one. */
+    int * dependents;
+
+    /** The number of tasks that depend on this one. */
+    int dependents_count;
+
+    /** The capacity of the array of dependents. */
+    int dependents_capacity;
+
+    /** The number of tasks this one depends on. */
+    int dependencies;
+
+    /** The number of dependencies that have not completed yet. */
+    atomic_int remaining;
+
+    /** The state of this task. */
+    _Atomic(enum node_state) state;
+
+    /** A possibly-null pointer to the exception thrown by this task. */
+    struct e4c_exception * exception;
+
+    /** The exception of this task when one of its dependencies failed. */
+    struct e4c_exception dependency_error;
+
+    /** A possibly-null pointer to the failure of this task. */
+    const struct e4c_exception * failure;
+};
+
+/**
+ * @internal
+ * @brief Represents a graph of tasks that depend on each other.
+ */
+struct e4c_task_graph {
+
+    /** The tasks of this graph. */
+    struct node * nodes;
+
+    /** The number of tasks of this graph. */
+    int count;
+
+    /** The capacity of the array of tasks. */
+    int capacity;
+
+    /** Protects the ready tasks. */
+    pthread_mutex_t mutex;
+
+    /** Signals that there are ready tasks, or that every task finished. */
+    pthread_cond_t condition;
+
+    /** The identifiers of the tasks that are ready to run. */
+    int * ready;
+
+    /** The number of tasks that are ready to run. */
+    int ready_count;
+
+    /** The number of tasks that finished, either completed or failed. */
+    atomic_int finished;
+
+    /** The number of tasks that failed. */
+    atomic_int failed;
+
+    /** The exception context the worker threads start from while the graph runs. */
+    struct e4c_context context;
+};
+
+/**
+ * @internal
+ * @brief Represents an exception thrown by a unit of parallel work.
+ */
+struct failure {
+
+    /** The index of the unit of work that failed. */
+    int index;
+
+    /** The captured exception. */
+    struct e4c_exception * exception;
+
+    /** A possibly-null pointer to the next failure. */
+    struct failure * next;
+};
+
+/**
+ * @internal
+ * @brief Represents a #PARALLEL_ERROR, along with every failure it was thrown for.
+ *
+ * The copies of the exceptions of the failures are stored right after the
+ * failures, in the same block of memory, so that they are deleted along
+ * with the #PARALLEL_ERROR.
+ */
+struct parallel_error {
+
+    /** The exception to throw; it MUST be the first member. */
+    struct e4c_exception exception;
+
+    /** The number of failures. */
+    int length;
+
+    /** The failures, sorted by index. */
+    struct failure failures[];
+};
+
+/**
+ * @internal
+ * @brief Represents a worker thread of a task graph.
+ */
+struct graph_worker {
+
+    /** The task graph this worker belongs to. */
+    struct e4c_task_graph * graph;
+
+    /** A stack big enough to hold every task, used to make downstream tasks fail. */
+    int * stack;
+
+    /** The thread that runs this worker. */
+    pthread_t thread;
+
+    /** Whether the thread that runs this worker was started. */
+    bool started;
+};
+
+/**
+ * @internal
+ * @brief Represents a task spawned in a #NURSERY block.
+ */
+struct task {
+
+    /** The function to run. */
+    void (*function)(void * argument);
+
+    /** The argument to pass to the function. */
+    void * argument;
+
+    /** The nursery this task belongs to. */
+    struct e4c_nursery * nursery;
+
+    /** The exception context of this task. */
+    struct e4c_context context;
+
+    /** The thread that runs this task. */
+    pthread_t thread;
+
+    /** A possibly-null pointer to the previously spawned task. */
+    struct task * next;
+};
+
+/**
+ * @internal
+ * @brief Represents a #NURSERY block.
+ */
+struct e4c_nursery {
+
+    /** A possibly-null pointer to the nursery of the task that created this one. */
+    struct e4c_nursery * outer;
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+
+    /** The cancellation token of the tasks of this nursery, derived from the token of the context that created it. */
+    struct e4c_cancellation_token token;
+
+#else
+
+    /** Whether the tasks of this nursery have been cancelled. */
+    atomic_bool cancelled;
+
+#endif
+
+    /** The number of exceptions thrown by tasks so far; used to tell which one was first. */
+    atomic_int sequence;
+
+    /** A possibly-null pointer to the most recent failure. */
+    _Atomic(struct failure *) failures;
+
+    /** A possibly-null pointer to the most recently spawned task. */
+    struct task * tasks;
+};
+
+/**
+ * @internal
+ * @brief Represents a worker thread of a parallel loop.
+ */
+struct worker {
+
+    /** Protects the range of indices of this worker. */
+    pthread_mutex_t mutex;
+
+    /** The first index this worker has yet to run. */
+    int begin;
+
+    /** The index past the last one this worker has yet to run. */
+    int end;
+
+    /** The position of this worker in the loop. */
+    int id;
+
+    /** The loop this worker belongs to. */
+    struct loop * loop;
+
+    /** The thread that runs this worker. */
+    pthread_t thread;
+
+    /** Whether the thread that runs this worker was started. */
+    bool started;
+};
+
+/**
+ * @internal
+ * @brief Represents a parallel loop.
+ */
+struct loop {
+
+    /** The function to call for each index. */
+    void (*function)(int index, void * argument);
+
+    /** The argument to pass to every function call. */
+    void * argument;
+
+    /** The number of indices each worker takes at a time. */
+    int grain;
+
+    /** The number of workers. */
+    int workers;
+
+    /** Whether the remaining indices are skipped as soon as one of them fails. */
+    bool cancel_on_failure;
+
+    /** Whether the remaining indices are being skipped. */
+    atomic_bool cancelled;
+
+    /** A possibly-null pointer to the most recent failure. */
+    _Atomic(struct failure *) failures;
+
+    /** The exception context the worker threads start from. */
+    struct e4c_context context;
+
+    /** The workers of this loop. */
+    struct worker * worker;
+};
+
+static noreturn void panic(const char * error_message);
+static void * run_task(void * data);
+static void * start_graph_worker(void * data);
+static void * run_graph_worker(void * data);
+static void finish_node(struct e4c_task_graph * graph, int id, int * stack);
+static void set_ready(struct e4c_task_graph * graph, int id);
+static void set_finished(struct e4c_task_graph * graph, int count);
+static bool has_cycle(const struct e4c_task_graph * graph);
+static void * start_worker(void * data);
+static void * run_worker(void * data);
+static bool take(struct worker * worker, int * begin, int * end);
+static bool steal(struct worker * thief);
+static void run_chunk(struct loop * loop, int begin, int end);
+static void add_failure(_Atomic(struct failure *) * failures, int index, struct e4c_exception * exception);
+static struct failure ** sort_failures(struct failure * failures, int * length);
+static void throw_failures(struct failure * failures, int count, const char * file, int line, const char * function);
+static void delete_failure(struct e4c_exception * exception);
+static bool is_parallel_error(const struct e4c_exception * exception);
+static int compare_failures(const void * first, const void * second);
+static struct e4c_cancellation_token * get_token(void);
+static void inherit_context(struct e4c_context * context, struct e4c_cancellation_token * token);
+static void cancel_nursery(struct e4c_nursery * nursery, const char * reason);
+static bool is_nursery_cancelled(struct e4c_nursery * nursery);
+
+/** A possibly-null pointer to the nursery of the task the current thread is running. */
+static _Thread_local struct e4c_nursery * current_nursery = NULL;
+
+void e4c_parallel_for(const int count, void (*function)(int index, void * argument), void * argument, const int threads, const bool cancel_on_failure) {
+    if (count <= 0 || function == NULL) {
+        return;
+    }
+    const int workers = threads < 1 ? 1 : threads > count ? count : threads;
+    const int grain = count / (workers * CHUNKS_PER_WORKER);
+    struct loop loop = {
+        .function           = function,
+        .argument           = argument,
+        .grain              = grain < 1 ? 1 : grain,
+        .workers            = workers,
+        .cancel_on_failure  = cancel_on_failure,
+        .worker             = calloc((size_t) workers, sizeof(struct worker))
+    };
+    if (loop.worker == NULL) {
+        THROW(PARALLEL_ERROR, "Not enough memory to run in parallel");
+    }
+    atomic_init(&loop.cancelled, false);
+    atomic_init(&loop.failures, NULL);
+    inherit_context(&loop.context, get_token());
+
+    /* every worker starts with an equal share of the indices */
+    for (int id = 0; id < workers; id++) {
+        struct worker * worker = &loop.worker[id];
+        (void) pthread_mutex_init(&worker->mutex, NULL);
+        worker->begin   = (int) ((long long) count * id / workers);
+        worker->end     = (int) ((long long) count * (id + 1) / workers);
+        worker->id      = id;
+        worker->loop    = &loop;
+    }
+
+    /* the calling thread is the first worker; if a thread cannot be created, its share will be stolen */
+    for (int id = 1; id < workers; id++) {
+        loop.worker[id].started = pthread_create(&loop.worker[id].thread, NULL, start_worker, &loop.worker[id]) == 0;
+    }
+    (void) run_worker(&loop.worker[0]);
+    for (int id = 1; id < workers; id++) {
+        if (loop.worker[id].started) {
+            (void) pthread_join(loop.worker[id].thread, NULL);
+        }
+    }
+
+    for (int id = 0; id < workers; id++) {
+        (void) pthread_mutex_destroy(&loop.worker[id].mutex);
+    }
+    free(loop.worker);
+
+    throw_failures(atomic_load(&loop.failures), count, EXCEPTIONS4C_DEBUG);
+}
+
+const struct e4c_exception * e4c_parallel_failure(const struct e4c_exception * exception, const int index) {
+    if (!is_parallel_error(exception)) {
+        return NULL;
+    }
+    const struct parallel_error * error = (const struct parallel_error *) exception;
+    int low = 0;
+    int high = error->length - 1;
+    while (low <= high) {
+        const int middle = low + (high - low) / 2;
+        if (error->failures[middle].index < index) {
+            low = middle + 1;
+        } else if (error->failures[middle].index > index) {
+            high = middle - 1;
+        } else {
+            return error->failures[middle].exception;
+        }
+    }
+    return NULL;
+}
+
+bool e4c_is_cancelled(void) {
+    for (struct e4c_nursery * nursery = current_nursery; nursery != NULL; nursery = nursery->outer) {
+        if (is_nursery_cancelled(nursery)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+struct e4c_nursery * e4c_nursery_start(const char * file, const int line, const char * function) {
+    struct e4c_nursery * nursery = calloc(1, sizeof(*nursery));
+    if (nursery == NULL) {
+        EXCEPTIONS4C_LONG_JUMP(e4c_throw(&PARALLEL_ERROR, "PARALLEL_ERROR", file, line, function, "Not enough memory to create a nursery"));
+    }
+    nursery->outer = current_nursery;
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+    e4c_derive_cancellation_token(&nursery->token, get_token());
+#else
+    atomic_init(&nursery->cancelled, false);
+#endif
+    atomic_init(&nursery->sequence, 0);
+    atomic_init(&nursery->failures, NULL);
+    return nursery;
+}
+
+void e4c_spawn(struct e4c_nursery * nursery, void (*task)(void * argument), void * argument, const char * file, const int line, const char * function) {
+    struct task * new_task = calloc(1, sizeof(*new_task));
+    if (new_task == NULL) {
+        EXCEPTIONS4C_LONG_JUMP(e4c_throw(&PARALLEL_ERROR, "PARALLEL_ERROR", file, line, function, "Not enough memory to spawn a task"));
+    }
+    new_task->function = task;
+    new_task->argument = argument;
+    new_task->nursery = nursery;
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+    inherit_context(&new_task->context, &nursery->token);
+#else
+    inherit_context(&new_task->context, NULL);
+#endif
+    if (pthread_create(&new_task->thread, NULL, run_task, new_task) != 0) {
+        free(new_task);
+        EXCEPTIONS4C_LONG_JUMP(e4c_throw(&PARALLEL_ERROR, "PARALLEL_ERROR", file, line, function, "Not enough resources to spawn a task"));
+    }
+    new_task->next = nursery->tasks;
+    nursery->tasks = new_task;
+}
+
+void e4c_nursery_wait(struct e4c_nursery * nursery, const char * file, const int line, const char * function) {
+    /* if the nursery block failed, its tasks are no longer needed */
+    const bool failed = e4c_is_uncaught();
+    if (failed) {
+        cancel_nursery(nursery, "The nursery block failed");
+    }
+    for (struct task * task = nursery->tasks, * next; task != NULL; task = next) {
+        next = task->next;
+        (void) pthread_join(task->thread, NULL);
+        free(task);
+    }
+    int length = 0;
+    struct failure ** sorted = sort_failures(atomic_load(&nursery->failures), &length);
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+    e4c_release_cancellation_token(&nursery->token);
+#endif
+    free(nursery);
+    if (length == 0) {
+        return;
+    }
+    /* the first exception will be thrown; the rest are suppressed */
+    struct e4c_exception * first = sorted[0]->exception;
+    for (int index = 0; index < length; index++) {
+        if (index > 0 || failed) {
+            delete_failure(sorted[index]->exception);
+        }
+        free(sorted[index]);
+    }
+    free(sorted);
+    if (!failed) {
+        EXCEPTIONS4C_LONG_JUMP(e4c_rethrow_captured(first, file, line, function));
+    }
+}
+
+struct e4c_task_graph * e4c_task_graph_create(void) {
+    struct e4c_task_graph * graph = calloc(1, sizeof(*graph));
+    if (graph == NULL) {
+        THROW(PARALLEL_ERROR, "Not enough memory to create a task graph");
+    }
+    return graph;
+}
+
+int e4c_task_graph_add(struct e4c_task_graph * graph, void (*task)(void * argument), void * argument) {
+    if (task == NULL) {
+        panic("Task is NULL.");
+    }
+    if (graph->count == graph->capacity) {
+        const int capacity = graph->capacity == 0 ? 16 : graph->capacity * 2;
+        struct node * nodes = realloc(graph->nodes, (size_t) capacity * sizeof(*nodes));
+        if (nodes == NULL) {
+            THROW(PARALLEL_ERROR, "Not enough memory to add a task");
+        }
+        graph->nodes = nodes;
+        graph->capacity = capacity;
+    }
+    struct node * node = &graph->nodes[graph->count];
+    (void) memset(node, 0, sizeof(*node));
+    node->function = task;
+    node->argument = argument;
+    return graph->count++;
+}
+
+void e4c_task_graph_depend(struct e4c_task_graph * graph, const int task, const int dependency) {
+    if (task < 0 || task >= graph->count || dependency < 0 || dependency >= graph->count) {
+        panic("Task identifier does not belong to the task graph.");
+    }
+    struct node * node = &graph->nodes[dependency];
+    if (node->dependents_count == node->dependents_capacity) {
+        const int capacity = node->dependents_capacity == 0 ? 4 : node->dependents_capacity * 2;
+        int * dependents = realloc(node->dependents, (size_t) capacity * sizeof(*dependents));
+        if (dependents == NULL) {
+            THROW(PARALLEL_ERROR, "Not enough memory to add a dependency");
+        }
+        node->dependents = dependents;
+        node->dependents_capacity = capacity;
+    }
+    node->dependents[node->dependents_count++] = task;
+    graph->nodes[task].dependencies++;
+}
+
+int e4c_task_graph_run(struct e4c_task_graph * graph, const int threads) {
+    if (has_cycle(graph)) {
+        THROW(PARALLEL_ERROR, "The task graph has a cycle");
+    }
+    const int workers = threads < 1 ? 1 : threads;
+    graph->ready = malloc((size_t) (graph->count + 1) * sizeof(*graph->ready));
+    struct graph_worker * worker = calloc((size_t) workers, sizeof(*worker));
+    bool allocated = graph->ready != NULL && worker != NULL;
+    for (int id = 0; allocated && id < workers; id++) {
+        worker[id].graph = graph;
+        worker[id].stack = malloc((size_t) (graph->count + 1) * sizeof(*worker[id].stack));
+        allocated = worker[id].stack != NULL;
+    }
+    if (!allocated) {
+        for (int id = 0; worker != NULL && id < workers; id++) {
+            free(worker[id].stack);
+        }
+        free(worker);
+        free(graph->ready);
+        graph->ready = NULL;
+        THROW(PARALLEL_ERROR, "Not enough memory to run a task graph");
+    }
+
+    /* forget about previous runs */
+    graph->ready_count = 0;
+    atomic_init(&graph->finished, 0);
+    atomic_init(&graph->failed, 0);
+    for (int id = 0; id < graph->count; id++) {
+        struct node * node = &graph->nodes[id];
+        free(node->exception);
+        node->exception = NULL;
+        node->failure = NULL;
+        atomic_init(&node->remaining, node->dependencies);
+        atomic_init(&node->state, PENDING);
+        if (node->dependencies == 0) {
+            graph->ready[graph->ready_count++] = id;
+        }
+    }
+    (void) pthread_mutex_init(&graph->mutex, NULL);
+    (void) pthread_cond_init(&graph->condition, NULL);
+    inherit_context(&graph->context, get_token());
+
+    /* the calling thread is the first worker; if a thread cannot be created, the others run its share */
+    for (int id = 1; id < workers; id++) {
+        worker[id].started = pthread_create(&worker[id].thread, NULL, start_graph_worker, &worker[id]) == 0;
+    }
+    (void) run_graph_worker(&worker[0]);
+    for (int id = 1; id < workers; id++) {
+        if (worker[id].started) {
+            (void) pthread_join(worker[id].thread, NULL);
+        }
+    }
+
+    for (int id = 0; id < workers; id++) {
+        free(worker[id].stack);
+    }
+    free(worker);
+    free(graph->ready);
+    graph->ready = NULL;
+    (void) pthread_cond_destroy(&graph->condition);
+    (void) pthread_mutex_destroy(&graph->mutex);
+    return atomic_load(&graph->failed);
+}
+
+const struct e4c_exception * e4c_task_graph_failure(const struct e4c_task_graph * graph, const int task) {
+    return task >= 0 && task < graph->count ? graph->nodes[task].failure : NULL;
+}
+
+void e4c_task_graph_delete(struct e4c_task_graph * graph) {
+    if (graph == NULL) {
+        return;
+    }
+    for (int id = 0; id < graph->count; id++) {
+        free(graph->nodes[id].dependents);
+        free(graph->nodes[id].exception);
+    }
+    free(graph->nodes);
+    free(graph);
+}
+
+/**
+ * Prints a fatal error message caused by misuse of this module, and aborts the program.
+ *
+ * @param error_message the message to print to standard error output.
+ */
+static noreturn void panic(const char * error_message) {
+    fprintf(stderr, "[exceptions4c] %s\n", error_message);
+    fflush(stderr);
+    abort();
+}
+
+/**
+ * Runs a task, collecting the exception it throws.
+ *
+ * @param data the task.
+ * @return <tt>NULL</tt>.
+ */
+static void * run_task(void * data) {
+    struct task * task = data;
+    struct e4c_nursery * nursery = task->nursery;
+    struct e4c_nursery * outer = current_nursery;
+    e4c_attach_context(&task->context);
+    current_nursery = nursery;
+    if (!e4c_is_cancelled()) {
+        TRY {
+            task->function(task->argument);
+        } CATCH_ALL {
+            add_failure(&nursery->failures, atomic_fetch_add(&nursery->sequence, 1), e4c_capture());
+            cancel_nursery(nursery, "A sibling task failed");
+        }
+    }
+    current_nursery = outer;
+    (void) e4c_detach_context();
+    return NULL;
+}
+
+/**
+ * Runs a worker of a task graph in a new thread, with its own exception context.
+ *
+ * @param data the worker.
+ * @return <tt>NULL</tt>.
+ */
+static void * start_graph_worker(void * data) {
+    const struct graph_worker * worker = data;
+    struct e4c_context context = worker->graph->context;
+    e4c_attach_context(&context);
+    (void) run_graph_worker(data);
+    (void) e4c_detach_context();
+    return NULL;
+}
+
+/**
+ * Runs the ready tasks of a task graph until every task has finished.
+ *
+ * @param data the worker.
+ * @return <tt>NULL</tt>.
+ */
+static void * run_graph_worker(void * data) {
+    const struct graph_worker * worker = data;
+    struct e4c_task_graph * graph = worker->graph;
+    int * stack = worker->stack;
+    for (;;) {
+        (void) pthread_mutex_lock(&graph->mutex);
+        while (graph->ready_count == 0 && atomic_load(&graph->finished) < graph->count) {
+            (void) pthread_cond_wait(&graph->condition, &graph->mutex);
+        }
+        if (graph->ready_count == 0) {
+            (void) pthread_mutex_unlock(&graph->mutex);
+            return NULL;
+        }
+        const int id = graph->ready[--graph->ready_count];
+        (void) pthread_mutex_unlock(&graph->mutex);
+        struct node * node = &graph->nodes[id];
+        enum node_state state = PENDING;
+        if (atomic_compare_exchange_strong(&node->state, &state, RUNNING)) {
+            TRY {
+                node->function(node->argument);
+            } CATCH_ALL {
+                node->exception = e4c_capture();
+                node->failure = node->exception;
+            }
+            atomic_store(&node->state, node->failure == NULL ? COMPLETED : FAILED);
+            finish_node(graph, id, stack);
+        }
+    }
+}
+
+/**
+ * Releases the dependents of a finished task, or makes them fail if the task failed.
+ *
+ * @param graph the task graph.
+ * @param id the identifier of the finished task.
+ * @param stack a stack big enough to hold every task.
+ */
+static void finish_node(struct e4c_task_graph * graph, const int id, int * stack) {
+    const struct node * node = &graph->nodes[id];
+    int finished = 1;
+    if (node->failure == NULL) {
+        for (int index = 0; index < node->dependents_count; index++) {
+            if (atomic_fetch_sub(&graph->nodes[node->dependents[index]].remaining, 1) == 1) {
+                set_ready(graph, node->dependents[index]);
+            }
+        }
+    } else {
+        /* every task downstream fails right away, with the failure of its dependency as the cause */
+        atomic_fetch_add(&graph->failed, 1);
+        int top = 0;
+        stack[top++] = id;
+        while (top > 0) {
+            const struct node * failed = &graph->nodes[stack[--top]];
+            for (int index = 0; index < failed->dependents_count; index++) {
+                const int dependent_id = failed->dependents[index];
+                struct node * dependent = &graph->nodes[dependent_id];
+                enum node_state state = PENDING;
+                if (atomic_compare_exchange_strong(&dependent->state, &state, SKIPPED)) {
+                    struct e4c_exception * exception = &dependent->dependency_error;
+                    (void) memset(exception, 0, sizeof(*exception));
+                    exception->type = &DEPENDENCY_ERROR;
+                    exception->name = "DEPENDENCY_ERROR";
+                    (void) snprintf(exception->message, sizeof(exception->message), "Task %d failed", (int) (failed - graph->nodes));
+                    exception->cause = (struct e4c_exception *) failed->failure;
+                    dependent->failure = exception;
+                    stack[top++] = dependent_id;
+                    atomic_fetch_add(&graph->failed, 1);
+                    finished++;
+                }
+            }
+        }
+    }
+    set_finished(graph, finished);
+}
+
+/**
+ * Adds a task to the ready tasks of a task graph.
+ *
+ * @param graph the task graph.
+ * @param id the identifier of the task.
+ */
+static void set_ready(struct e4c_task_graph * graph, const int id) {
+    (void) pthread_mutex_lock(&graph->mutex);
+    graph->ready[graph->ready_count++] = id;
+    (void) pthread_cond_signal(&graph->condition);
+    (void) pthread_mutex_unlock(&graph->mutex);
+}
+
+/**
+ * Counts finished tasks, and wakes up every worker when there are none left.
+ *
+ * @param graph the task graph.
+ * @param count the number of tasks that just finished.
+ */
+static void set_finished(struct e4c_task_graph * graph, const int count) {
+    if (atomic_fetch_add(&graph->finished, count) + count == graph->count) {
+        (void) pthread_mutex_lock(&graph->mutex);
+        (void) pthread_cond_broadcast(&graph->condition);
+        (void) pthread_mutex_unlock(&graph->mutex);
+    }
+}
+
+/**
+ * Determines whether a task graph has a cycle.
+ *
+ * @param graph the task graph.
+ * @return <tt>true</tt> if some tasks depend on each other in a cycle; <tt>false</tt> otherwise.
+ */
+static bool has_cycle(const struct e4c_task_graph * graph) {
+    int * remaining = malloc((size_t) (graph->count + 1) * sizeof(*remaining));
+    int * ready = malloc((size_t) (graph->count + 1) * sizeof(*ready));
+    if (remaining == NULL || ready == NULL) {
+        free(remaining);
+        free(ready);
+        THROW(PARALLEL_ERROR, "Not enough memory to check a task graph");
+    }
+    int ready_count = 0;
+    for (int id = 0; id < graph->count; id++) {
+        remaining[id] = graph->nodes[id].dependencies;
+        if (remaining[id] == 0) {
+            ready[ready_count++] = id;
+        }
+    }
+    int visited = 0;
+    while (ready_count > 0) {
+        const struct node * node = &graph->nodes[ready[--ready_count]];
+        visited++;
+        for (int index = 0; index < node->dependents_count; index++) {
+            if (--remaining[node->dependents[index]] == 0) {
+                ready[ready_count++] = node->dependents[index];
+            }
+        }
+    }
+    free(remaining);
+    free(ready);
+    return visited < graph->count;
+}
+
+/**
+ * Runs a worker of a parallel loop in a new thread, with its own exception context.
+ *
+ * @param data the worker.
+ * @return <tt>NULL</tt>.
+ */
+static void * start_worker(void * data) {
+    const struct worker * worker = data;
+    struct e4c_context context = worker->loop->context;
+    e4c_attach_context(&context);
+    (void) run_worker(data);
+    (void) e4c_detach_context();
+    return NULL;
+}
+
+/**
+ * Runs chunks of indices until there are none left.
+ *
+ * @param data the worker.
+ * @return <tt>NULL</tt>.
+ */
+static void * run_worker(void * data) {
+    struct worker * worker = data;
+    struct loop * loop = worker->loop;
+    int begin;
+    int end;
+    while (!atomic_load_explicit(&loop->cancelled, memory_order_relaxed) && (take(worker, &begin, &end) || (steal(worker) && take(worker, &begin, &end)))) {
+        run_chunk(loop, begin, end);
+    }
+    return NULL;
+}
+
+/**
+ * Takes the next chunk of indices of a worker.
+ *
+ * @param worker the worker.
+ * @param begin the first index of the chunk.
+ * @param end the index past the last one of the chunk.
+ * @return <tt>true</tt> if the worker had indices left; <tt>false</tt> otherwise.
+ */
+static bool take(struct worker * worker, int * begin, int * end) {
+    (void) pthread_mutex_lock(&worker->mutex);
+    const bool taken = worker->begin < worker->end;
+    if (taken) {
+        *begin = worker->begin;
+        *end = worker->end - worker->begin > worker->loop->grain ? worker->begin + worker->loop->grain : worker->end;
+        worker->begin = *end;
+    }
+    (void) pthread_mutex_unlock(&worker->mutex);
+    return taken;
+}
+
+/**
+ * Moves the second half of the remaining indices of another worker to the supplied worker.
+ *
+ * @param thief the worker that ran out of indices.
+ * @return <tt>true</tt> if some indices were stolen; <tt>false</tt> if no worker had indices left.
+ */
+static bool steal(struct worker * thief) {
+    struct loop * loop = thief->loop;
+    for (int offset = 1; offset < loop->workers; offset++) {
+        struct worker * victim = &loop->worker[(thief->id + offset) % loop->workers];
+        (void) pthread_mutex_lock(&victim->mutex);
+        const int remaining = victim->end - victim->begin;
+        const int end = victim->end;
+        victim->end -= (remaining + 1) / 2;
+        (void) pthread_mutex_unlock(&victim->mutex);
+        if (remaining > 0) {
+            (void) pthread_mutex_lock(&thief->mutex);
+            thief->begin = end - (remaining + 1) / 2;
+            thief->end = end;
+            (void) pthread_mutex_unlock(&thief->mutex);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Runs a chunk of indices, collecting the exceptions thrown by each of them.
+ *
+ * @param loop the parallel loop.
+ * @param begin the first index of the chunk.
+ * @param end the index past the last one of the chunk.
+ */
+static void run_chunk(struct loop * loop, const int begin, const int end) {
+    volatile int index = begin; /* NOSONAR */
+    while (index < end && !atomic_load_explicit(&loop->cancelled, memory_order_relaxed)) {
+        TRY {
+            for (; index < end && !atomic_load_explicit(&loop->cancelled, memory_order_relaxed); index++) {
+                loop->function(index, loop->argument);
+            }
+        } CATCH_ALL {
+            add_failure(&loop->failures, index, e4c_capture());
+            if (loop->cancel_on_failure) {
+                atomic_store_explicit(&loop->cancelled, true, memory_order_relaxed);
+            }
+            /* carry on with the next index */
+            index++;
+        }
+    }
+}
+
+/**
+ * Adds an exception to a list of failures, without taking a lock.
+ *
+ * @param failures the list of failures.
+ * @param index the index of the unit of work that failed.
+ * @param exception the captured exception.
+ */
+static void add_failure(_Atomic(struct failure *) * failures, const int index, struct e4c_exception * exception) {
+    struct failure * failure = malloc(sizeof(*failure));
+    if (failure == NULL) {
+        delete_failure(exception);
+        return;
+    }
+    failure->index = index;
+    failure->exception = exception;
+    failure->next = atomic_load_explicit(failures, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(failures, &failure->next, failure, memory_order_release, memory_order_relaxed)) {
+        /* retry with the updated head */
+    }
+}
+
+/**
+ * Sorts a list of failures by index.
+ *
+ * @param failures a possibly-null pointer to the list of failures.
+ * @param length the number of failures.
+ * @return a possibly-null pointer to a new array with the sorted failures.
+ */
+static struct failure ** sort_failures(struct failure * failures, int * length) {
+    *length = 0;
+    for (const struct failure * failure = failures; failure != NULL; failure = failure->next) {
+        (*length)++;
+    }
+    if (*length == 0) {
+        return NULL;
+    }
+    struct failure ** sorted = malloc((size_t) *length * sizeof(*sorted));
+    if (sorted == NULL) {
+        THROW(PARALLEL_ERROR, "Not enough memory to collect %d failures", *length);
+    }
+    *length = 0;
+    for (struct failure * failure = failures; failure != NULL; failure = failure->next) {
+        sorted[(*length)++] = failure;
+    }
+    qsort(sorted, (size_t) *length, sizeof(*sorted), compare_failures);
+    return sorted;
+}
+
+/**
+ * Throws a #PARALLEL_ERROR if there were any failures, which are moved into it.
+ *
+ * @param failures a possibly-null pointer to the list of failures.
+ * @param count the total number of units of work.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ */
+static void throw_failures(struct failure * failures, const int count, const char * file, const int line, const char * function) {
+    int length = 0;
+    struct failure ** sorted = sort_failures(failures, &length);
+    if (length == 0) {
+        return;
+    }
+
+    /* the exceptions of every failure are copied to the same block of memory */
+    size_t exceptions = 0;
+    for (int index = 0; index < length; index++) {
+        for (const struct e4c_exception * cause = sorted[index]->exception; cause != NULL; cause = cause->cause) {
+            exceptions++;
+        }
+    }
+    const size_t alignment = _Alignof(struct e4c_exception);
+    const size_t offset = (offsetof(struct parallel_error, failures) + (size_t) length * sizeof(struct failure) + alignment - 1) / alignment * alignment;
+    struct parallel_error * error = malloc(offset + exceptions * sizeof(struct e4c_exception));
+    if (error == NULL) {
+        for (int index = 0; index < length; index++) {
+            delete_failure(sorted[index]->exception);
+            free(sorted[index]);
+        }
+        free(sorted);
+        THROW(PARALLEL_ERROR, "Not enough memory to collect %d failures", length);
+    }
+    struct e4c_exception * copy = (struct e4c_exception *) ((char *) error + offset);
+    for (int index = 0; index < length; index++) {
+        error->failures[index].index = sorted[index]->index;
+        error->failures[index].exception = copy;
+        error->failures[index].next = NULL;
+        for (const struct e4c_exception * cause = sorted[index]->exception; cause != NULL; cause = cause->cause, copy++) {
+            *copy = *cause;
+            copy->cause = cause->cause != NULL ? copy + 1 : NULL;
+            copy->_allocation = error;
+        }
+        free(sorted[index]->exception);
+        free(sorted[index]);
+    }
+    free(sorted);
+    error->length = length;
+
+    /* list every failure in the message, as long as it fits */
+    struct e4c_exception * exception = &error->exception;
+    (void) memset(exception, 0, sizeof(*exception));
+    size_t size = (size_t) snprintf(exception->message, sizeof(exception->message), "%d of %d failed:", length, count);
+    for (int index = 0; index < length && size < sizeof(exception->message); index++) {
+        const struct e4c_exception * failure = error->failures[index].exception;
+        size += (size_t) snprintf(exception->message + size, sizeof(exception->message) - size, " [%d] %s: %s;", error->failures[index].index, failure->name, failure->message);
+    }
+    if (size >= sizeof(exception->message)) {
+        (void) memcpy(exception->message + sizeof(exception->message) - sizeof("..."), "...", sizeof("..."));
+    }
+
+    /* the first failure will be the cause */
+    exception->type = &PARALLEL_ERROR;
+    exception->name = "PARALLEL_ERROR";
+#ifndef EXCEPTIONS4C_NO_DEBUG_INFO
+    exception->file = file;
+    exception->line = line;
+    exception->function = function;
+#endif
+#ifndef EXCEPTIONS4C_NO_ERRNO
+    exception->error_number = errno;
+#endif
+    exception->cause = error->failures[0].exception;
+    exception->_allocation = error;
+    EXCEPTIONS4C_LONG_JUMP(e4c_rethrow_captured(exception, file, line, function));
+}
+
+/**
+ * Deletes a captured exception that will not be thrown, finalizing it first.
+ *
+ * @param exception the captured exception.
+ */
+static void delete_failure(struct e4c_exception * exception) {
+#ifndef EXCEPTIONS4C_NO_HOOKS
+    const struct e4c_context * context = e4c_get_context();
+    for (struct e4c_exception * cause = exception; cause != NULL && context->finalize_exception != NULL; cause = cause->cause) {
+        context->finalize_exception(cause);
+    }
+#endif
+    free(exception);
+}
+
+/**
+ * Determines whether an exception is a #PARALLEL_ERROR that holds its failures.
+ *
+ * Captured exceptions share one block of memory too, but their causes are
+ * stored right after them, while the failures of a #PARALLEL_ERROR are not.
+ *
+ * @param exception a possibly-null pointer to the exception.
+ * @return <tt>true</tt> if the failures of the exception can be retrieved; <tt>false</tt> otherwise.
+ */
+static bool is_parallel_error(const struct e4c_exception * exception) {
+    return exception != NULL
+        && exception->type == &PARALLEL_ERROR
+        && exception->_allocation == exception
+        && exception->cause != NULL
+        && exception->cause != exception + 1;
+}
+
+/**
+ * Compares two failures by index.
+ *
+ * @param first the first failure.
+ * @param second the second failure.
+ * @return a negative number, zero, or a positive number if the first index is lower than, equal to, or greater than the second one.
+ */
+static int compare_failures(const void * first, const void * second) {
+    const int first_index = (*(const struct failure * const *) first)->index;
+    const int second_index = (*(const struct failure * const *) second)->index;
+    return (first_index > second_index) - (first_index < second_index);
+}
+
+/**
+ * Prepares an exception context for a worker thread, with the handlers of the current exception context.
+ *
+ * @param context the exception context to prepare.
+ * @param token a possibly-null pointer to the cancellation token of the worker thread.
+ */
+static void inherit_context(struct e4c_context * context, struct e4c_cancellation_token * token) {
+    const struct e4c_context * parent = e4c_get_context();
+    (void) memset(context, 0, sizeof(*context));
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+    context->_cancellation_token = token;
+#else
+    (void) token;
+#endif
+#ifndef EXCEPTIONS4C_NO_HOOKS
+    context->uncaught_handler = parent->uncaught_handler;
+    context->termination_handler = parent->termination_handler;
+    context->initialize_exception = parent->initialize_exception;
+    context->finalize_exception = parent->finalize_exception;
+#else
+    (void) parent;
+#endif
+}
+
+/**
+ * Retrieves the cancellation token of the current exception context, so that it can be shared with other threads.
+ *
+ * @return the cancellation token of the current exception context, or <tt>NULL</tt>.
+ */
+static struct e4c_cancellation_token * get_token(void) {
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+    return e4c_get_cancellation_token(e4c_get_context());
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * Cancels the tasks of a nursery.
+ *
+ * @param nursery the nursery.
+ * @param reason the reason why the tasks are cancelled.
+ */
+static void cancel_nursery(struct e4c_nursery * nursery, const char * reason) {
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+    (void) e4c_cancel(&nursery->token, reason);
+#else
+    (void) reason;
+    atomic_store_explicit(&nursery->cancelled, true, memory_order_relaxed);
+#endif
+}
+
+/**
+ * Determines whether the tasks of a nursery have been cancelled.
+ *
+ * @param nursery the nursery.
+ * @return <tt>true</tt> if the tasks of the nursery have been cancelled; <tt>false</tt> otherwise.
+ */
+static bool is_nursery_cancelled(struct e4c_nursery * nursery) {
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+    return e4c_get_cancellation_reason(&nursery->token) != NULL;
+#else
+    return atomic_load_explicit(&nursery->cancelled, memory_order_relaxed);
+#endif
+}
@@ -0,0 +1,352 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * Parallel execution built on exceptions4c.
+ *
+ * This module runs work on several threads, collecting the exceptions
+ * thrown by each thread and throwing them again in the calling thread.
+ *
+ * ```c
+ * #include <exceptions4c-parallel.h>
+ * ```
+ *
+ * Each thread started by this module [attaches](#e4c_attach_context) an
+ * exception context of its own, which inherits the handlers and the
+ * cancellation token of the calling thread's context. The calling thread
+ * keeps using its own context.
+ *
+ * @file        exceptions4c-parallel.h
+ * @version     4.0.0
+ * @author      [Guillermo Calvo](https://guillermo.dev)
+ * @copyright   Licensed under Apache 2.0
+ * @see         For more information, visit the
+ *              [project on GitHub](https://github.com/guillermocalvo/exceptions4c)
+ */
+
+#ifndef EXCEPTIONS4C_PARALLEL
+
+/**
+ * Returns the major version number of this module.
+ */
+#define EXCEPTIONS4C_PARALLEL 4
+
+#include <exceptions4c.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Introduces a block of code that spawns concurrent tasks.
+ *
+ * A #NURSERY block works like a #TRY block, except that it waits for every
+ * task [spawned](#SPAWN) inside of it before moving on to its #CATCH and
+ * #FINALLY blocks.
+ *
+ * ```c
+ * NURSERY {
+ *   SPAWN(fetch_shard, &shard[0]);
+ *   SPAWN(fetch_shard, &shard[1]);
+ * } CATCH (SHARD_ERROR) {
+ *   printf("Shard failed: %s\n", e4c_get_exception()->message);
+ * }
+ * ```
+ *
+ * As soon as one of the tasks throws an exception, the remaining tasks are
+ * cancelled: those not started yet are skipped, and those running can check
+ * #e4c_is_cancelled, or reach a #CHECKPOINT, to stop early. Once every task
+ * has finished, the first exception thrown by a task is thrown again in the
+ * current thread, so that it can be handled by the #CATCH blocks next to the
+ * #NURSERY block.
+ * Exceptions thrown by the other tasks are suppressed: they are
+ * [finalized](#e4c_context.finalize_exception) and deleted.
+ *
+ * If the #NURSERY block itself throws an exception, the tasks are cancelled
+ * too, and the exceptions they throw are suppressed.
+ *
+ * Tasks get a [cancellation token](#e4c_cancellation_token) of their own,
+ * derived from the token of the context that created the #NURSERY block.
+ *
+ * @see SPAWN
+ * @see e4c_is_cancelled
+ */
+#define NURSERY                                                             \
+                                                                            \
+  for (                                                                     \
+    struct e4c_nursery * exceptions4c_nursery = e4c_nursery_start(          \
+      EXCEPTIONS4C_DEBUG                                                    \
+    );                                                                      \
+    exceptions4c_nursery != NULL;                                           \
+    exceptions4c_nursery = NULL                                             \
+  )                                                                         \
+  EXCEPTIONS4C_START_BLOCK(true, false)                                     \
+  if (e4c_dispose(EXCEPTIONS4C_DEBUG)) {                                    \
+    e4c_nursery_wait(exceptions4c_nursery, EXCEPTIONS4C_DEBUG);             \
+  } else if (e4c_acquire(EXCEPTIONS4C_DEBUG)) {                             \
+  } else if (e4c_try(EXCEPTIONS4C_DEBUG))
+
+/**
+ * Starts a concurrent task in the current #NURSERY block.
+ *
+ * @param function the function to run.
+ * @param argument a possibly-null pointer to pass to the function.
+ *
+ * The task runs on its own thread. This macro MUST be used directly in the
+ * body of a #NURSERY block. If the thread cannot be created, a
+ * #PARALLEL_ERROR is thrown, so the tasks spawned so far are cancelled.
+ *
+ * @see NURSERY
+ */
+#define SPAWN(function, argument)                                           \
+                                                                            \
+  e4c_spawn(exceptions4c_nursery, (function), (argument), EXCEPTIONS4C_DEBUG)
+
+/**
+ * Represents the failure of one or more units of parallel work.
+ *
+ * The message of a #PARALLEL_ERROR lists the indices, names, and messages
+ * of the exceptions thrown by each failed unit of work, in ascending order,
+ * as long as they fit; otherwise, it ends with an ellipsis. Its
+ * [cause](#e4c_exception.cause) is the first of those exceptions, along
+ * with its own causes. The exception thrown by each failed unit of work
+ * can be retrieved via #e4c_parallel_failure.
+ *
+ * @see e4c_parallel_failure
+ */
+extern const struct e4c_exception_type PARALLEL_ERROR;
+
+/**
+ * Represents the failure of a task whose dependency failed.
+ *
+ * The [cause](#e4c_exception.cause) of a #DEPENDENCY_ERROR is the failure
+ * of the dependency, which may be a #DEPENDENCY_ERROR itself. The end of
+ * the chain is the exception thrown by the upstream task.
+ *
+ * @see e4c_task_graph_run
+ */
+extern const struct e4c_exception_type DEPENDENCY_ERROR;
+
+/**
+ * Represents a graph of tasks that depend on each other.
+ *
+ * @see e4c_task_graph_create
+ */
+struct e4c_task_graph;
+
+/**
+ * Runs a function for each index in a range, using several threads.
+ *
+ * @param count the number of indices to run; the function is called for every index from zero to <tt>count - 1</tt>.
+ * @param function the function to call for each index.
+ * @param argument a possibly-null pointer to pass to every function call.
+ * @param threads the number of threads to use, including the calling thread.
+ * @param cancel_on_failure if <tt>true</tt>, the remaining indices are skipped as soon as one of them fails.
+ *
+ * The range is split into chunks, which are run by worker threads created
+ * for this call. Each worker starts with an equal share of the chunks; when
+ * it runs out of them, it steals half of the remaining chunks of another
+ * worker. The calling thread takes part as one of the workers.
+ *
+ * Exceptions thrown by the function are caught by the worker that ran it,
+ * which then continues with the next index. Once every worker has finished,
+ * if any index failed, a #PARALLEL_ERROR is thrown in the calling thread.
+ *
+ * @see PARALLEL_ERROR
+ * @see e4c_parallel_failure
+ */
+void e4c_parallel_for(int count, void (*function)(int index, void * argument), void * argument, int threads, bool cancel_on_failure);
+
+/**
+ * Retrieves the exception thrown by an index of a parallel loop.
+ *
+ * @param exception a possibly-null pointer to the #PARALLEL_ERROR thrown by #e4c_parallel_for.
+ * @param index the index.
+ * @return the exception thrown by the index, along with its causes;
+ *   <tt>NULL</tt> if the index did not fail, or the supplied exception is
+ *   not a #PARALLEL_ERROR thrown by #e4c_parallel_for.
+ *
+ * The exception belongs to the #PARALLEL_ERROR, and it is deleted along
+ * with it. Failures are not [captured](#e4c_capture) along with the
+ * #PARALLEL_ERROR.
+ *
+ * ```c
+ * TRY {
+ *   e4c_parallel_for(count, process, items, 4, false);
+ * } CATCH (PARALLEL_ERROR) {
+ *   for (int index = 0; index < count; index++) {
+ *     const struct e4c_exception * failure = e4c_parallel_failure(e4c_get_exception(), index);
+ *     if (failure != NULL) {
+ *       printf("Item %d failed: %s\n", index, failure->message);
+ *     }
+ *   }
+ * }
+ * ```
+ *
+ * @see PARALLEL_ERROR
+ */
+const struct e4c_exception * e4c_parallel_failure(const struct e4c_exception * exception, int index);
+
+/**
+ * Creates a new, empty task graph.
+ *
+ * @return the new task graph.
+ *
+ * @see e4c_task_graph_add
+ * @see e4c_task_graph_delete
+ */
+struct e4c_task_graph * e4c_task_graph_create(void);
+
+/**
+ * Adds a task to a task graph.
+ *
+ * @param graph the task graph.
+ * @param task the function to run.
+ * @param argument a possibly-null pointer to pass to the function.
+ * @return the identifier of the new task.
+ *
+ * Task identifiers are consecutive, starting at zero.
+ *
+ * @pre
+ *   - <tt>task</tt> MUST NOT be <tt>NULL</tt>; otherwise, the program will
+ *     be abruptly terminated.
+ *
+ * @see e4c_task_graph_depend
+ */
+int e4c_task_graph_add(struct e4c_task_graph * graph, void (*task)(void * argument), void * argument);
+
+/**
+ * Makes a task depend on another one.
+ *
+ * @param graph the task graph.
+ * @param task the identifier of the dependent task.
+ * @param dependency the identifier of the task it depends on.
+ *
+ * The dependent task will not run until its dependency completes.
+ *
+ * @pre
+ *   - Both <tt>task</tt> and <tt>dependency</tt> MUST have been returned by
+ *     #e4c_task_graph_add for the supplied graph; otherwise, the program will
+ *     be abruptly terminated.
+ */
+void e4c_task_graph_depend(struct e4c_task_graph * graph, int task, int dependency);
+
+/**
+ * Runs every task of a task graph, using several threads.
+ *
+ * @param graph the task graph.
+ * @param threads the number of threads to use, including the calling thread.
+ * @return the number of tasks that failed.
+ *
+ * Each task runs as soon as all of its dependencies complete. When a task
+ * throws an exception, every task downstream of it fails immediately,
+ * without running, with a #DEPENDENCY_ERROR whose cause is the failure
+ * of its dependency. The failure of each task can be retrieved afterwards
+ * via #e4c_task_graph_failure.
+ *
+ * A #PARALLEL_ERROR is thrown if the graph has a cycle, or there is not
+ * enough memory to run it.
+ *
+ * @see e4c_task_graph_failure
+ */
+int e4c_task_graph_run(struct e4c_task_graph * graph, int threads);
+
+/**
+ * Retrieves the failure of a task after running its task graph.
+ *
+ * @param graph the task graph.
+ * @param task the identifier of the task.
+ * @return the exception thrown by the task, or a #DEPENDENCY_ERROR if
+ *   one of its dependencies failed; <tt>NULL</tt> if it completed.
+ *
+ * The exception belongs to the task graph, and it is deleted along with it.
+ */
+const struct e4c_exception * e4c_task_graph_failure(const struct e4c_task_graph * graph, int task);
+
+/**
+ * Deletes a task graph, along with the failures of its tasks.
+ *
+ * @param graph the task graph.
+ */
+void e4c_task_graph_delete(struct e4c_task_graph * graph);
+
+/**
+ * Determines whether the current task has been cancelled.
+ *
+ * @return <tt>true</tt> if the #NURSERY block of the current task, or any
+ *   of its outer #NURSERY blocks, has been cancelled, or the cancellation
+ *   token they derive from was cancelled; <tt>false</tt> otherwise.
+ *
+ * Long-running tasks SHOULD check this function periodically, and stop
+ * as soon as possible when it returns <tt>true</tt>.
+ *
+ * @see NURSERY
+ */
+bool e4c_is_cancelled(void);
+
+/**
+ * @internal
+ * @brief Represents a #NURSERY block.
+ */
+struct e4c_nursery;
+
+/**
+ * @internal
+ * @brief Creates a new nursery.
+ *
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @return the new nursery.
+ *
+ * @warning This function SHOULD be called only via #NURSERY.
+ */
+struct e4c_nursery * e4c_nursery_start(const char * file, int line, const char * function);
+
+/**
+ * @internal
+ * @brief Starts a new task in a nursery.
+ *
+ * @param nursery the nursery.
+ * @param task the function to run.
+ * @param argument a possibly-null pointer to pass to the function.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ *
+ * @warning This function SHOULD be called only via #SPAWN.
+ */
+void e4c_spawn(struct e4c_nursery * nursery, void (*task)(void * argument), void * argument, const char * file, int line, const char * function);
+
+/**
+ * @internal
+ * @brief Waits for every task of a nursery, deletes it, and throws the first exception thrown by a task.
+ *
+ * @param nursery the nursery.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ *
+ * @warning This function SHOULD be called only via #NURSERY.
+ */
+void e4c_nursery_wait(struct e4c_nursery * nursery, const char * file, int line, const char * function);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
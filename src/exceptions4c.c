@@ -29,10 +29,107 @@
 
 #include <stdio.h>
 #include <errno.h>
+#include <signal.h>
 #include <stdarg.h>
 #include <stdnoreturn.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
 #include <exceptions4c.h>
 
+#ifdef HAVE_LIBPTHREAD
+#include <pthread.h>
+#endif
+
+#ifndef EXCEPTIONS4C_CACHE_LINE_SIZE
+/** @internal The size of a cache line, used to align per-thread exception contexts. */
+#define EXCEPTIONS4C_CACHE_LINE_SIZE 64
+#endif
+
+#ifndef EXCEPTIONS4C_MAX_ATTACHED_CONTEXTS
+/** @internal The maximum nesting depth of attached exception contexts per thread. */
+#define EXCEPTIONS4C_MAX_ATTACHED_CONTEXTS 16
+#endif
+
+#ifndef EXCEPTIONS4C_SIGNAL_SLOTS
+/** @internal The number of exceptions thrown from signal handlers that each thread can hold at the same time. */
+#define EXCEPTIONS4C_SIGNAL_SLOTS 4
+#endif
+
+#ifdef SA_SIGINFO
+/** @internal Signals can be mapped to exceptions in this platform. */
+#define EXCEPTIONS4C_SIGNAL_MAPPING
+#endif
+
+#ifdef NSIG
+/** @internal The number of signals that can be mapped to exceptions. */
+#define SIGNAL_COUNT NSIG
+#else
+/** @internal The number of signals that can be mapped to exceptions. */
+#define SIGNAL_COUNT 65
+#endif
+
+#if defined(EXCEPTIONS4C_SIGNAL_MAPPING) && defined(HAVE_LIBPTHREAD) && defined(HAVE_PTHREAD_GETATTR_NP) && defined(SA_ONSTACK)
+/** @internal Stack overflows can be detected in this platform. */
+#define EXCEPTIONS4C_STACK_OVERFLOW
+/* declared only when _GNU_SOURCE is defined */
+extern int pthread_getattr_np(pthread_t thread, pthread_attr_t * attributes);
+#endif
+
+#if defined(EXCEPTIONS4C_SIGNAL_MAPPING) && defined(HAVE_LIBPTHREAD) && defined(HAVE_TIMER_CREATE) && defined(SIGEV_THREAD_ID)
+/** @internal Deadlines can be enforced in this platform. */
+#define EXCEPTIONS4C_DEADLINES
+#include <unistd.h>
+#include <sys/syscall.h>
+#ifndef sigev_notify_thread_id
+/* not defined by older C libraries */
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+#ifndef EXCEPTIONS4C_DEADLINE_SIGNAL
+/** @internal The signal that notifies the expiration of deadlines. */
+#define EXCEPTIONS4C_DEADLINE_SIGNAL SIGRTMIN
+#endif
+
+#ifndef EXCEPTIONS4C_DEADLINE_RETRY
+/** @internal The milliseconds to wait before delivering a deadline that expired while library code was running. */
+#define EXCEPTIONS4C_DEADLINE_RETRY 1
+#endif
+
+#ifndef EXCEPTIONS4C_MAX_WATCHED_BLOCKS
+/** @internal The maximum number of exception blocks per registered context that can be snapshotted. */
+#define EXCEPTIONS4C_MAX_WATCHED_BLOCKS 16
+#endif
+
+#ifndef EXCEPTIONS4C_ALTERNATE_STACK_SIZE
+/** @internal The size of the alternate signal stack stack overflows are handled on. */
+#define EXCEPTIONS4C_ALTERNATE_STACK_SIZE 65536
+#endif
+
+#ifndef EXCEPTIONS4C_STACK_OVERFLOW_MARGIN
+/** @internal The minimum stack space left to the exception block a stack overflow is thrown to. */
+#define EXCEPTIONS4C_STACK_OVERFLOW_MARGIN 32768
+#endif
+
+#ifndef EXCEPTIONS4C_NO_ERRNO
+/** @internal Captures the value of errno for new exceptions. */
+#define ERROR_NUMBER errno
+#else
+/** @internal Discards the value of errno for new exceptions. */
+#define ERROR_NUMBER 0
+#endif
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+/** @internal The reason a cancellation token was cancelled, as an atomic object; the public field is a plain pointer. */
+#define CANCELLATION_REASON(token) ((_Atomic(const char *) *) &(token)->_reason)
+/** @internal The state of the tokens derived from a cancellation token, as an atomic object. */
+#define DERIVED_TOKENS_STATE(token) ((atomic_int *) &(token)->_state)
+/** @internal The state of the tokens derived from a cancellation token while they are being changed. */
+#define DERIVED_TOKENS_CHANGING (-1)
+#endif
+
 /**
  * @internal
  * @brief Represents the execution stage of the current exception block.
@@ -40,25 +137,25 @@
 enum block_stage {
 
     /** @internal The exception block has started. */
-    BEGINNING,
+    BEGINNING = E4C_STAGE_BEGINNING,
 
     /** @internal The exception block is [acquiring a resource](#WITH). */
-    ACQUIRING,
+    ACQUIRING = E4C_STAGE_ACQUIRING,
 
     /** @internal The exception block is [trying something](#TRY) or [using a resource](#USE). */
-    TRYING,
+    TRYING = E4C_STAGE_TRYING,
 
     /** @internal The exception block is [disposing of a resource](#WITH). */
-    DISPOSING,
+    DISPOSING = E4C_STAGE_DISPOSING,
 
     /** @internal The exception block is [catching an exception](#CATCH). */
-    CATCHING,
+    CATCHING = E4C_STAGE_CATCHING,
 
     /** @internal The exception block is [finalizing](#FINALLY). */
-    FINALIZING,
+    FINALIZING = E4C_STAGE_FINALIZING,
 
     /** @internal The exception block has finished. */
-    DONE
+    DONE = E4C_STAGE_DONE
 };
 
 /**
@@ -70,6 +167,25 @@ struct e4c_block {
     /** A possibly-null pointer to the outer exception block. */
     struct e4c_block * outer_block;
 
+    /** The approximate position in the stack of the function that started this block. */
+    const void * stack;
+
+    /** The number of exception blocks from the outermost one to this one. */
+    int depth;
+
+    /** A possibly-null pointer to the memory region that was being probed when this block started. */
+    struct e4c_probe * probe;
+
+    /** Whether this block is running against a deadline. */
+    bool deadline;
+
+#ifdef EXCEPTIONS4C_DEADLINES
+
+    /** The moment the deadline of this block expires, which is never later than the one of the outer deadline. */
+    struct timespec expiration;
+
+#endif
+
     /** The stage of this block. */
     enum block_stage stage;
 
@@ -79,50 +195,603 @@ struct e4c_block {
     /** A possibly-null pointer to the currently thrown exceptions. */
     struct e4c_exception * exception;
 
+#ifndef EXCEPTIONS4C_NO_RETRY
+
     /** Current number of times the #TRY block has been attempted. */
     int retry_attempts;
 
     /** Current number of times the #WITH block has been attempted. */
     int reacquire_attempts;
 
+    /** The delay before the block was last repeated with a backoff policy, in milliseconds. */
+    long backoff_delay;
+
+    /** The moment the block was first repeated with a backoff policy, in milliseconds. */
+    long long backoff_started;
+
+#endif
+
     /** The execution context of this exception block. */
     e4c_env env;
 };
 
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+
+/**
+ * @internal
+ * @brief Represents an exception block published so that other threads can take snapshots of it.
+ *
+ * Every field is atomic, since snapshots are read while the owner thread updates them.
+ */
+struct watched_block {
+
+    /** The stage of the exception block. */
+    atomic_int stage;
+
+    /** The name of the source code file that started the exception block. */
+    _Atomic(const char *) file;
+
+    /** The number of line that started the exception block. */
+    atomic_int line;
+
+    /** The name of the function that started the exception block. */
+    _Atomic(const char *) function;
+
+    /** The moment the exception block started, in nanoseconds. */
+    atomic_llong started;
+};
+
+/**
+ * @internal
+ * @brief Represents an entry of the context registry.
+ *
+ * Entries are never deallocated; unlinked entries are reused. This way, the
+ * registry can be traversed while other threads link or unlink contexts.
+ */
+struct registry_entry {
+
+    /** A possibly-null pointer to the registered context; <tt>NULL</tt> if this entry is free. */
+    _Atomic(struct e4c_context *) context;
+
+    /** The number of exception blocks currently open in the registered context. */
+    atomic_int blocks;
+
+    /** The number of exceptions currently alive in the registered context. */
+    atomic_int exceptions;
+
+    /** Odd while the registered context is updating its watched blocks; incremented twice per update. */
+    atomic_uint sequence;
+
+    /** The number of exception blocks open in the registered context, as seen by its watched blocks. */
+    atomic_int depth;
+
+    /** The outermost exception blocks of the registered context. */
+    struct watched_block watched[EXCEPTIONS4C_MAX_WATCHED_BLOCKS];
+
+    /** A possibly-null pointer to the next entry of the registry. */
+    struct registry_entry * next;
+};
+
+#endif
+
+/**
+ * @internal
+ * @brief Represents the exception context of a thread.
+ */
+struct thread_context {
+
+    /** The exception context, aligned to a cache line to prevent false sharing. */
+    _Alignas(EXCEPTIONS4C_CACHE_LINE_SIZE) struct e4c_context context;
+
+    /** Whether the exception context has been initialized. */
+    bool initialized;
+};
+
+/**
+ * @internal
+ * @brief Represents a preallocated exception to be thrown from a signal handler.
+ */
+struct signal_slot {
+
+    /** The preallocated exception; it MUST be the first member. */
+    struct e4c_exception exception;
+
+    /** The signal the exception was thrown from, if any. */
+    struct e4c_signal_info info;
+
+    /** A possibly-null pointer to the exception suppressed by this one, to be deleted along with it outside of the signal handler. */
+    struct e4c_exception * suppressed;
+
+    /** Whether the exception is currently in use; slots are claimed atomically, since a signal may interrupt the claim. */
+    atomic_bool in_use;
+};
+
 static noreturn void panic(const char * error_message, const char * file, int line, const char * function);
 static void * allocate(size_t size, const char * error_message, const char * file, int line, const char * function);
 static struct e4c_context * get_context(const char * file, int line, const char * function);
+static struct e4c_context * get_signal_context(void);
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+static void propagate_cancellation(struct e4c_cancellation_token * token, const char * reason);
+static void start_changing_derived_tokens(struct e4c_cancellation_token * token);
+static void finish_changing_derived_tokens(struct e4c_cancellation_token * token);
+#endif
 static void cleanup_default_context(void);
+static struct e4c_context * get_thread_context(void);
+#ifdef HAVE_LIBPTHREAD
+static void cleanup_thread_context(void * data);
+#endif
+static void count(const struct e4c_context * context, int blocks, int exceptions);
+static void watch(const struct e4c_context * context, const struct e4c_block * block, bool is_new, const char * file, int line, const char * function);
+static inline bool is_registered(const struct e4c_context * context);
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+static int snapshot_entry(struct registry_entry * entry, struct e4c_block_snapshot snapshots[], int max_snapshots);
+#endif
+#if !defined(EXCEPTIONS4C_NO_REGISTRY) || !defined(EXCEPTIONS4C_NO_RETRY)
+static long long get_nanoseconds(void);
+#endif
+#ifndef EXCEPTIONS4C_NO_RETRY
+static e4c_env * restart(bool should_reacquire, int max_attempts, const struct e4c_backoff * policy, const struct e4c_exception_type * type, const char * name, int error_number, const char * file, int line, const char * function, const char * format, va_list arguments_list);
+static long get_backoff_delay(const struct e4c_backoff * policy, const struct e4c_block * block, int attempts);
+static long long get_milliseconds(void);
+static void sleep_milliseconds(long milliseconds);
+#endif
+static void delete_block(const struct e4c_context * context, struct e4c_block * block);
+#ifdef EXCEPTIONS4C_DEADLINES
+static void start_deadline(struct e4c_block * block, long milliseconds, const char * file, int line, const char * function);
+static void stop_deadline(struct e4c_block * block);
+static void set_deadline_timer(const struct timespec * expiration);
+static const struct e4c_block * find_deadline(const struct e4c_block * block);
+static bool has_expired(const struct timespec * expiration);
+static bool is_deadline_exceeded(const struct e4c_context * context);
+static void handle_deadline(int signal_number, siginfo_t * info, void * ucontext);
+static void create_deadline_key(void);
+static void delete_deadline_timer(void * timer);
+#endif
+static void capture_cause(const struct e4c_context * context, struct e4c_exception * exception);
+#ifdef EXCEPTIONS4C_SIGNAL_MAPPING
+static void handle_signal(int signal_number, siginfo_t * info, void * ucontext);
+static void unblock_signal(int signal_number);
+static void forward_signal(const struct sigaction * previous, int signal_number, siginfo_t * info, void * ucontext);
+static bool install_signal_handler(int signal_number);
+#endif
+#ifdef EXCEPTIONS4C_STACK_OVERFLOW
+static bool is_close_to_stack_limit(const void * address);
+static struct e4c_block * find_overflow_target(const struct e4c_context * context);
+static void abandon_blocks(struct e4c_context * context, struct e4c_block * target);
+static void install_segfault_handler(void);
+static void create_alternate_stack_key(void);
+static void delete_alternate_stack(void * stack);
+static int release_abandoned_blocks(const struct e4c_context * context);
+#endif
 static void throw(const struct e4c_context * context, const struct e4c_exception_type * type, const char * name, int error_number, const char * file, int line, const char * function, const char * format, va_list arguments_list);
+static void throw_from_signal(const struct e4c_context * context, const struct e4c_exception_type * type, const char * name, int error_number, const char * file, int line, const char * function, const char * message, const struct e4c_signal_info * info);
+static e4c_env * probe_fail(const struct e4c_probe * probe, const char * file, int line, const char * function);
 static void propagate(const struct e4c_context * context, struct e4c_exception * exception);
 static enum block_stage get_stage(const char * file, int line, const char * function);
 static void delete_exception(const struct e4c_context * context, struct e4c_exception * exception);
 static void print_debug_info(const char * file, int line, const char * function);
 static void print_exception(const struct e4c_exception * exception, bool is_cause);
 static bool extends(const struct e4c_exception_type * type, const struct e4c_exception_type * supertype);
+static int get_family_id(const struct e4c_exception_family * family, const struct e4c_exception_type * type);
+
+/** Identifies the backend and the feature profile the library was compiled with. */
+const int EXCEPTIONS4C_ABI = EXCEPTIONS4C_BACKEND;
 
 /** Stores the exception context supplier. */
 static struct e4c_context * (*context_supplier)(void) = NULL;
 
 /** Default exception context of the program when no custom supplier is provided. */
 static struct e4c_context default_context = {
-    ._innermost_block = NULL,
-    .initialize_exception = NULL,
-    .finalize_exception = NULL,
-    .uncaught_handler = NULL
+    ._innermost_block = NULL
 };
 
 /** Flag that determines if the exception system has been already initialized. */
 static bool is_cleanup_registered = false;
 
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+
+/** Whether new thread-local contexts are linked to the context registry. */
+static atomic_bool is_registry_enabled = false;
+
+/** A possibly-null pointer to the most recent entry of the context registry. */
+static _Atomic(struct registry_entry *) registry = NULL;
+
+/** Whether some thread took snapshots of exception blocks, so that their starting time needs to be tracked. */
+static atomic_bool is_watchdog_enabled = false;
+
+#endif
+
+/** A possibly-null pointer to the active exception context of the current thread, overriding the supplier. */
+static _Thread_local struct e4c_context * active_context = NULL;
+
+/** The contexts that were active when the currently attached contexts of the current thread were attached. */
+static _Thread_local struct e4c_context * detached_contexts[EXCEPTIONS4C_MAX_ATTACHED_CONTEXTS];
+
+/** The exception contexts currently attached to the current thread, from the outermost to the innermost. */
+static _Thread_local struct e4c_context * attached_context_stack[EXCEPTIONS4C_MAX_ATTACHED_CONTEXTS];
+
+/** The number of nested exception contexts attached to the current thread. */
+static _Thread_local int attached_contexts = 0;
+
+/** Preallocated exceptions of the current thread, to be thrown from signal handlers. */
+static _Thread_local struct signal_slot signal_slots[EXCEPTIONS4C_SIGNAL_SLOTS];
+
+/** Marks exceptions thrown from signal handlers, so that their slots are released instead of freed. */
+static const char signal_allocation = 0;
+
+const struct e4c_exception_type STACK_OVERFLOW = {.supertype = NULL, .default_message = "Stack overflow"};
+const struct e4c_exception_type SIGNAL_ERROR = {.supertype = NULL, .default_message = "Signal received"};
+const struct e4c_exception_type SEGMENTATION_FAULT = {.supertype = &SIGNAL_ERROR, .default_message = "Segmentation fault"};
+const struct e4c_exception_type BUS_ERROR = {.supertype = &SIGNAL_ERROR, .default_message = "Bus error"};
+const struct e4c_exception_type ARITHMETIC_ERROR = {.supertype = &SIGNAL_ERROR, .default_message = "Arithmetic error"};
+const struct e4c_exception_type ILLEGAL_INSTRUCTION = {.supertype = &SIGNAL_ERROR, .default_message = "Illegal instruction"};
+const struct e4c_exception_type BROKEN_PIPE = {.supertype = &SIGNAL_ERROR, .default_message = "Broken pipe"};
+const struct e4c_exception_type MAPPED_IO_ERROR = {.supertype = &SIGNAL_ERROR, .default_message = "Mapped memory could not be accessed"};
+const struct e4c_exception_type DEADLINE_EXCEEDED = {.supertype = NULL, .default_message = "Deadline exceeded"};
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+const struct e4c_exception_type CANCELLED = {.supertype = NULL, .default_message = "Cancelled"};
+#endif
+
+/** A possibly-null pointer to the innermost memory region being probed by the current thread. */
+static _Thread_local struct e4c_probe * active_probe = NULL;
+
+/** Exception context of the current thread when #e4c_thread_context is the context supplier. */
+static _Thread_local struct thread_context thread_context;
+
+#ifndef EXCEPTIONS4C_NO_RETRY
+
+/** The state of the pseudo-random generator that jitters the backoff delays of the current thread; zero until seeded. */
+static _Thread_local unsigned long long jitter_state = 0;
+
+#endif
+
+#ifdef EXCEPTIONS4C_SIGNAL_MAPPING
+
+/** The signal mappings used when none are supplied. */
+static const struct e4c_signal_mapping default_signal_mappings[] = {
+    SIGNAL_MAPPING(SIGSEGV, SEGMENTATION_FAULT),
+    SIGNAL_MAPPING(SIGBUS, BUS_ERROR),
+    SIGNAL_MAPPING(SIGFPE, ARITHMETIC_ERROR),
+    SIGNAL_MAPPING(SIGILL, ILLEGAL_INSTRUCTION),
+    SIGNAL_MAPPING(SIGPIPE, BROKEN_PIPE)
+};
+
+/** The exception types signals are turned into, indexed by signal number. */
+static struct e4c_signal_mapping signal_mappings[SIGNAL_COUNT];
+
+/** The actions that were in place before signals were handled, indexed by signal number. */
+static struct sigaction previous_actions[SIGNAL_COUNT];
+
+/** Whether the handlers for the signals raised by probed memory regions were installed. */
+static atomic_bool are_probe_handlers_installed = false;
+
+#endif
+
+#ifdef EXCEPTIONS4C_DEADLINES
+
+/** The timer that notifies the current thread when its innermost deadline expires. */
+static _Thread_local timer_t deadline_timer;
+
+/** Whether the deadline timer of the current thread is armed, so that expired deadlines need to be looked for. */
+static _Thread_local volatile sig_atomic_t is_deadline_timer_armed = false;
+
+/** Whether the deadline timer of the current thread was created. */
+static _Thread_local bool is_deadline_timer_created = false;
+
+/** The number of nested library calls of the current thread that must not be interrupted by deadlines. */
+static _Thread_local volatile sig_atomic_t uninterruptible_calls = 0;
+
+/** Ensures that the deadline handler is installed, and the deadline timer key is created, only once. */
+static pthread_once_t deadline_once = PTHREAD_ONCE_INIT;
+
+/** Whether the handler for the deadline signal was installed. */
+static bool is_deadline_handler_installed = false;
+
+/** Thread-specific key whose destructor deletes the deadline timer of exiting threads. */
+static pthread_key_t deadline_key;
+
+/** The action that was in place before the handler for the deadline signal was installed. */
+static struct sigaction previous_deadline_action;
+
+#endif
+
+#ifdef EXCEPTIONS4C_STACK_OVERFLOW
+
+/** The lowest address of the stack of the current thread, if stack overflows are handled. */
+static _Thread_local const char * stack_limit = NULL;
+
+/** Exception blocks of the current thread abandoned by a stack overflow, to be deleted outside the signal handler. */
+static _Thread_local struct e4c_block * abandoned_blocks = NULL;
+
+/** Whether the handler for SIGSEGV was installed. */
+static bool is_segfault_handler_installed = false;
+
+/** Ensures that the handler for SIGSEGV is installed only once. */
+static pthread_once_t segfault_handler_once = PTHREAD_ONCE_INIT;
+
+/** Ensures that the alternate stack cleanup key is created only once. */
+static pthread_once_t alternate_stack_once = PTHREAD_ONCE_INIT;
+
+/** Thread-specific key whose destructor deletes the alternate signal stack of exiting threads. */
+static pthread_key_t alternate_stack_key;
+
+#endif
+
+#ifdef HAVE_LIBPTHREAD
+
+/** Ensures that the thread cleanup key is created only once. */
+static pthread_once_t thread_cleanup_once = PTHREAD_ONCE_INIT;
+
+/** Thread-specific key whose destructor cleans up the exception context of exiting threads. */
+static pthread_key_t thread_cleanup_key;
+
+/** Creates the thread-specific key that cleans up exception contexts. */
+static void create_thread_cleanup_key(void) {
+    if (pthread_key_create(&thread_cleanup_key, cleanup_thread_context) != 0) {
+        panic("Thread cleanup key could not be created.", NULL, 0, NULL);
+    }
+}
+
+#endif
+
 void e4c_set_context_supplier(struct e4c_context * (*supplier)(void)) {
     context_supplier = supplier;
 }
 
 struct e4c_context * e4c_get_context(void) {
+    if (active_context != NULL) {
+        return active_context;
+    }
+    if (context_supplier == e4c_thread_context) {
+        /* direct call, so that the per-thread context can be inlined */
+        return get_thread_context();
+    }
     return context_supplier != NULL ? context_supplier() : &default_context;
 }
 
+struct e4c_context * e4c_thread_context(void) {
+    return get_thread_context();
+}
+
+struct e4c_context * e4c_switch_context(struct e4c_context * context) {
+    struct e4c_context * previous = active_context;
+    active_context = context;
+    return previous;
+}
+
+void e4c_attach_context(struct e4c_context * context) {
+    if (context == NULL) {
+        panic("Attached exception context is NULL.", NULL, 0, NULL);
+    }
+    if (context == active_context) {
+        panic("Exception context is already attached.", NULL, 0, NULL);
+    }
+    if (attached_contexts >= EXCEPTIONS4C_MAX_ATTACHED_CONTEXTS) {
+        panic("Too many nested exception contexts attached.", NULL, 0, NULL);
+    }
+    detached_contexts[attached_contexts] = active_context;
+    attached_context_stack[attached_contexts++] = context;
+    active_context = context;
+}
+
+struct e4c_context * e4c_detach_context(void) {
+    struct e4c_context * context = active_context;
+    if (attached_contexts == 0) {
+        panic("No exception context attached.", NULL, 0, NULL);
+    }
+    if (context != attached_context_stack[attached_contexts - 1]) {
+        panic("Detached exception context is not the attached one. Some context switch may not have been undone.", NULL, 0, NULL);
+    }
+    if (context != NULL && context->_innermost_block != NULL) {
+        panic("Detached exception context has live blocks. Some `TRY` block may still be running or may have been exited improperly.", NULL, 0, NULL);
+    }
+    active_context = detached_contexts[--attached_contexts];
+    return context;
+}
+
+bool e4c_handle_stack_overflow(void) {
+#ifdef EXCEPTIONS4C_STACK_OVERFLOW
+    /* create the context of the current thread now, since the signal handler will not */
+    (void) e4c_get_context();
+    if (stack_limit != NULL) {
+        return true;
+    }
+    pthread_attr_t attributes;
+    void * stack_address;
+    size_t stack_size;
+    if (pthread_getattr_np(pthread_self(), &attributes) != 0) {
+        return false;
+    }
+    const int result = pthread_attr_getstack(&attributes, &stack_address, &stack_size);
+    (void) pthread_attr_destroy(&attributes);
+    if (result != 0) {
+        return false;
+    }
+    (void) pthread_once(&segfault_handler_once, install_segfault_handler);
+    (void) pthread_once(&alternate_stack_once, create_alternate_stack_key);
+    if (!is_segfault_handler_installed) {
+        return false;
+    }
+    /* the signal handler needs a stack of its own, since the thread's stack is exhausted */
+    stack_t alternate_stack = {
+        .ss_sp      = malloc(EXCEPTIONS4C_ALTERNATE_STACK_SIZE),
+        .ss_size    = EXCEPTIONS4C_ALTERNATE_STACK_SIZE,
+        .ss_flags   = 0
+    };
+    if (alternate_stack.ss_sp == NULL || sigaltstack(&alternate_stack, NULL) != 0) {
+        free(alternate_stack.ss_sp);
+        return false;
+    }
+    if (pthread_setspecific(alternate_stack_key, alternate_stack.ss_sp) != 0) {
+        delete_alternate_stack(alternate_stack.ss_sp);
+        return false;
+    }
+    stack_limit = stack_address;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool e4c_map_signals(const struct e4c_signal_mapping * mappings, int count) {
+#ifdef EXCEPTIONS4C_SIGNAL_MAPPING
+    /* create the context of the current thread now, since the signal handler will not */
+    (void) e4c_get_context();
+    if (mappings == NULL) {
+        mappings = default_signal_mappings;
+        count = (int) (sizeof(default_signal_mappings) / sizeof(default_signal_mappings[0]));
+    }
+    bool installed = true;
+    for (int index = 0; index < count; index++) {
+        const int signal_number = mappings[index].signal_number;
+        if (signal_number <= 0 || signal_number >= SIGNAL_COUNT) {
+            installed = false;
+            continue;
+        }
+        signal_mappings[signal_number] = mappings[index];
+        if (!install_signal_handler(signal_number)) {
+            installed = false;
+        }
+    }
+    return installed;
+#else
+    (void) mappings;
+    (void) count;
+    return false;
+#endif
+}
+
+const struct e4c_signal_info * e4c_get_signal_info(const struct e4c_exception * exception) {
+    if (exception == NULL || exception->_allocation != &signal_allocation) {
+        return NULL;
+    }
+    const struct e4c_signal_info * info = &((const struct signal_slot *) exception)->info;
+    return info->signal_number != 0 ? info : NULL;
+}
+
+bool e4c_probe_next(struct e4c_probe * probe, const char * file, const int line, const char * function) {
+    if (probe->_stage == 0) {
+#ifdef EXCEPTIONS4C_SIGNAL_MAPPING
+        if (!atomic_load_explicit(&are_probe_handlers_installed, memory_order_relaxed)) {
+            (void) install_signal_handler(SIGBUS);
+            (void) install_signal_handler(SIGSEGV);
+            atomic_store_explicit(&are_probe_handlers_installed, true, memory_order_relaxed);
+        }
+#endif
+        probe->_stage = 1;
+        probe->_outer = active_probe;
+        active_probe = probe;
+        return true;
+    }
+    probe->_stage = 2;
+    active_probe = probe->_outer;
+    if (probe->_info.signal_number != 0) {
+        EXCEPTIONS4C_LONG_JUMP(probe_fail(probe, file, line, function));
+    }
+    return false;
+}
+
+void e4c_defer_deadlines(void) {
+#ifdef EXCEPTIONS4C_DEADLINES
+    uninterruptible_calls++;
+#endif
+}
+
+void e4c_resume_deadlines(void) {
+#ifdef EXCEPTIONS4C_DEADLINES
+    if (uninterruptible_calls <= 0) {
+        panic("Deadlines were not deferred.", NULL, 0, NULL);
+    }
+    uninterruptible_calls--;
+#endif
+}
+
+struct e4c_reset_report e4c_context_reset(struct e4c_context * context) {
+    for (int index = 0; index < attached_contexts; index++) {
+        if (attached_context_stack[index] == context) {
+            panic("Exception context cannot be reset while it is attached.", NULL, 0, NULL);
+        }
+    }
+    struct e4c_reset_report report = {0};
+    while (context->_innermost_block != NULL) {
+        struct e4c_block * block = context->_innermost_block;
+        context->_innermost_block = block->outer_block;
+        for (const struct e4c_exception * exception = block->exception; exception != NULL; exception = exception->cause) {
+            report.exceptions++;
+        }
+        delete_block(context, block);
+        report.blocks++;
+    }
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+    context->_cancellation_token = NULL;
+#endif
+    return report;
+}
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+
+struct e4c_cancellation_token * e4c_set_cancellation_token(struct e4c_context * context, struct e4c_cancellation_token * token) {
+    struct e4c_cancellation_token * previous = context->_cancellation_token;
+    context->_cancellation_token = token;
+    return previous;
+}
+
+struct e4c_cancellation_token * e4c_get_cancellation_token(const struct e4c_context * context) {
+    return context->_cancellation_token;
+}
+
+bool e4c_cancel(struct e4c_cancellation_token * token, const char * reason) {
+    const char * expected = NULL;
+    const char * effective_reason = reason != NULL ? reason : CANCELLED.default_message;
+    if (!atomic_compare_exchange_strong(CANCELLATION_REASON(token), &expected, effective_reason)) {
+        return false;
+    }
+    propagate_cancellation(token, effective_reason);
+    return true;
+}
+
+const char * e4c_get_cancellation_reason(const struct e4c_cancellation_token * token) {
+    /* cancellation is propagated to derived tokens, so there is no need to look at the token this one derives from */
+    return token != NULL ? atomic_load(CANCELLATION_REASON(token)) : NULL;
+}
+
+void e4c_derive_cancellation_token(struct e4c_cancellation_token * token, struct e4c_cancellation_token * parent) {
+    token->_parent = parent;
+    if (parent != NULL) {
+        start_changing_derived_tokens(parent);
+        token->_sibling = parent->_children;
+        parent->_children = token;
+        finish_changing_derived_tokens(parent);
+    }
+}
+
+void e4c_release_cancellation_token(struct e4c_cancellation_token * token) {
+    struct e4c_cancellation_token * parent = token->_parent;
+    if (parent != NULL) {
+        start_changing_derived_tokens(parent);
+        for (struct e4c_cancellation_token ** link = &parent->_children; *link != NULL; link = &(*link)->_sibling) {
+            if (*link == token) {
+                *link = token->_sibling;
+                break;
+            }
+        }
+        finish_changing_derived_tokens(parent);
+        token->_parent = NULL;
+        token->_sibling = NULL;
+    }
+}
+
+void e4c_checkpoint(const char * file, const int line, const char * function) {
+    const struct e4c_cancellation_token * token = get_context(file, line, function)->_cancellation_token;
+    /* the reason is loaded again to make sure its contents are visible */
+    const char * reason = e4c_get_cancellation_reason(token);
+    if (reason != NULL) {
+        EXCEPTIONS4C_LONG_JUMP(e4c_throw(&CANCELLED, "CANCELLED", file, line, function, "%s", reason));
+    }
+}
+
+#endif
+
 const struct e4c_exception * e4c_get_exception(void) {
     const struct e4c_context * context = e4c_get_context();
     return context != NULL && context->_innermost_block != NULL ? ((struct e4c_block *) context->_innermost_block)->exception : NULL;
@@ -133,7 +802,184 @@ bool e4c_is_uncaught(void) {
     return context != NULL && context->_innermost_block != NULL && ((struct e4c_block *) context->_innermost_block)->uncaught;
 }
 
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+
+void e4c_enable_context_registry(void) {
+    atomic_store(&is_registry_enabled, true);
+    e4c_register_context(&default_context);
+}
+
+void e4c_register_context(struct e4c_context * context) {
+    if (context == NULL || context->_registry != NULL) {
+        return;
+    }
+    /* reuse a free entry, if any */
+    for (struct registry_entry * entry = atomic_load_explicit(&registry, memory_order_acquire); entry != NULL; entry = entry->next) {
+        struct e4c_context * free_entry = NULL;
+        if (atomic_load_explicit(&entry->context, memory_order_relaxed) == NULL && atomic_compare_exchange_strong(&entry->context, &free_entry, context)) {
+            context->_registry = entry;
+            return;
+        }
+    }
+    /* otherwise, push a new entry */
+    struct registry_entry * entry = allocate(sizeof(*entry), "Not enough memory to register an exception context", NULL, 0, NULL);
+    atomic_init(&entry->context, context);
+    atomic_init(&entry->blocks, 0);
+    atomic_init(&entry->exceptions, 0);
+    atomic_init(&entry->sequence, 0);
+    atomic_init(&entry->depth, 0);
+    for (int index = 0; index < EXCEPTIONS4C_MAX_WATCHED_BLOCKS; index++) {
+        atomic_init(&entry->watched[index].stage, BEGINNING);
+        atomic_init(&entry->watched[index].file, NULL);
+        atomic_init(&entry->watched[index].line, 0);
+        atomic_init(&entry->watched[index].function, NULL);
+        atomic_init(&entry->watched[index].started, 0);
+    }
+    entry->next = atomic_load_explicit(&registry, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&registry, &entry->next, entry, memory_order_release, memory_order_relaxed)) {
+        /* retry with the updated head */
+    }
+    context->_registry = entry;
+}
+
+void e4c_unregister_context(struct e4c_context * context) {
+    if (context == NULL || context->_registry == NULL) {
+        return;
+    }
+    struct registry_entry * entry = context->_registry;
+    context->_registry = NULL;
+    atomic_store_explicit(&entry->blocks, 0, memory_order_relaxed);
+    atomic_store_explicit(&entry->exceptions, 0, memory_order_relaxed);
+    atomic_store_explicit(&entry->depth, 0, memory_order_relaxed);
+    atomic_store_explicit(&entry->context, NULL, memory_order_release);
+}
+
+struct e4c_statistics e4c_get_statistics(void) {
+    struct e4c_statistics statistics = {0, 0, 0, 0};
+    for (struct registry_entry * entry = atomic_load_explicit(&registry, memory_order_acquire); entry != NULL; entry = entry->next) {
+        if (atomic_load_explicit(&entry->context, memory_order_acquire) == NULL) {
+            continue;
+        }
+        const int depth = atomic_load_explicit(&entry->depth, memory_order_relaxed);
+        statistics.contexts++;
+        statistics.blocks += atomic_load_explicit(&entry->blocks, memory_order_relaxed);
+        statistics.exceptions += atomic_load_explicit(&entry->exceptions, memory_order_relaxed);
+        if (depth > statistics.max_depth) {
+            statistics.max_depth = depth;
+        }
+    }
+    return statistics;
+}
+
+int e4c_snapshot_context(const struct e4c_context * context, struct e4c_block_snapshot snapshots[], const int max_snapshots) {
+    return context != NULL && context->_registry != NULL ? snapshot_entry(context->_registry, snapshots, max_snapshots) : 0;
+}
+
+int e4c_watchdog_scan(const long milliseconds, void (*report)(const struct e4c_context * context, const struct e4c_block_snapshot * block, void * argument), void * argument) {
+    struct e4c_block_snapshot snapshots[EXCEPTIONS4C_MAX_WATCHED_BLOCKS];
+    int reported = 0;
+    for (struct registry_entry * entry = atomic_load_explicit(&registry, memory_order_acquire); entry != NULL; entry = entry->next) {
+        const struct e4c_context * context = atomic_load_explicit(&entry->context, memory_order_acquire);
+        if (context == NULL) {
+            continue;
+        }
+        const int depth = snapshot_entry(entry, snapshots, EXCEPTIONS4C_MAX_WATCHED_BLOCKS);
+        for (int index = 0; index < depth && index < EXCEPTIONS4C_MAX_WATCHED_BLOCKS; index++) {
+            if (snapshots[index].milliseconds > milliseconds) {
+                report(context, &snapshots[index], argument);
+                reported++;
+            }
+        }
+    }
+    return reported;
+}
+
+#endif
+
+struct e4c_exception * e4c_capture(void) {
+    const struct e4c_exception * exception = e4c_get_exception();
+    if (exception == NULL) {
+        return NULL;
+    }
+    /* the exception and its causes are copied to a single block of memory */
+    size_t length = 0;
+    for (const struct e4c_exception * cause = exception; cause != NULL; cause = cause->cause) {
+        length++;
+    }
+    struct e4c_exception * captured = allocate(length * sizeof(*captured), "Not enough memory to capture an exception", NULL, 0, NULL);
+    for (size_t index = 0; index < length; index++, exception = exception->cause) {
+        captured[index]             = *exception;
+        captured[index].cause       = index + 1 < length ? &captured[index + 1] : NULL;
+#ifndef EXCEPTIONS4C_NO_HOOKS
+        captured[index].data        = NULL;
+#endif
+        captured[index]._allocation = captured;
+    }
+    return captured;
+}
+
+bool e4c_operation_fail(struct e4c_operation * operation) {
+    if (operation->_failure != NULL) {
+        return false;
+    }
+    operation->_failure = e4c_capture();
+    return operation->_failure != NULL;
+}
+
+struct e4c_exception * e4c_operation_take(struct e4c_operation * operation) {
+    struct e4c_exception * failure = operation->_failure;
+    operation->_failure = NULL;
+    return failure;
+}
+
+bool e4c_register_type(const struct e4c_exception_type * type) {
+    if (type == NULL || (type->display != NULL && type->display->ancestors != NULL)) {
+        return true;
+    }
+    /* detect cycles (Floyd's algorithm) and count the supertypes */
+    int depth = 0;
+    for (const struct e4c_exception_type * slow = type, * fast = type; fast != NULL; depth++) {
+        fast = fast->supertype;
+        if (depth % 2 == 1) {
+            slow = slow->supertype;
+        }
+        if (fast != NULL && fast == slow) {
+            return false;
+        }
+    }
+    depth--;
+    /* allocate the array of ancestors only if some type of the hierarchy can store it */
+    bool is_stored = false;
+    for (const struct e4c_exception_type * ancestor = type; ancestor != NULL && !is_stored; ancestor = ancestor->supertype) {
+        is_stored = ancestor->display != NULL && ancestor->display->ancestors == NULL;
+    }
+    if (!is_stored) {
+        return true;
+    }
+    /* all types in the hierarchy share the same array of ancestors */
+    const struct e4c_exception_type ** ancestors = allocate((size_t) (depth + 1) * sizeof(*ancestors), "Not enough memory to register an exception type", NULL, 0, NULL);
+    for (int index = depth; type != NULL; index--, type = type->supertype) {
+        ancestors[index] = type;
+        if (type->display != NULL && type->display->ancestors == NULL) {
+            type->display->depth = index;
+            type->display->ancestors = ancestors;
+        }
+    }
+    return true;
+}
+
 e4c_env * e4c_start(const bool should_acquire, const char * file, const int line, const char * function) {
+#ifdef EXCEPTIONS4C_STACK_OVERFLOW
+    /* throw right away if the stack is about to overflow, so that it never overflows while allocating memory */
+    if (is_close_to_stack_limit(&file)) {
+        struct e4c_context * context = get_context(file, line, function);
+        struct e4c_block * target = find_overflow_target(context);
+        if (target != NULL) {
+            abandon_blocks(context, target);
+            EXCEPTIONS4C_LONG_JUMP(e4c_throw(&STACK_OVERFLOW, "STACK_OVERFLOW", file, line, function, NULL));
+        }
+    }
+#endif
     struct e4c_block * new_block = allocate(sizeof(*new_block), "Not enough memory to create a new exception block", file, line, function);
     struct e4c_context * context = get_context(file, line, function);
     if (context == &default_context && !is_cleanup_registered) {
@@ -144,13 +990,25 @@ e4c_env * e4c_start(const bool should_acquire, const char * file, const int line
     }
 
     new_block->outer_block          = context->_innermost_block;
+    new_block->stack                = &new_block;
+    new_block->depth                = context->_innermost_block != NULL ? ((struct e4c_block *) context->_innermost_block)->depth + 1 : 1;
+    new_block->probe                = active_probe;
+    new_block->deadline             = false;
     new_block->stage                = should_acquire ? BEGINNING : ACQUIRING;
     new_block->uncaught             = false;
+    new_block->exception            = NULL;
+#ifndef EXCEPTIONS4C_NO_RETRY
     new_block->reacquire_attempts   = 0;
     new_block->retry_attempts       = 0;
-    new_block->exception            = NULL;
+    new_block->backoff_delay        = 0;
+    new_block->backoff_started      = 0;
+#endif
 
     context->_innermost_block = new_block;
+    if (is_registered(context)) {
+        count(context, +1, 0);
+        watch(context, new_block, true, file, line, function);
+    }
 
     return &new_block->env;
 }
@@ -161,10 +1019,22 @@ bool e4c_next(const char * file, const int line, const char * function) {
     if (block == NULL) {
         panic("Invalid exception context state.", file, line, function);
     }
+#ifdef EXCEPTIONS4C_STACK_OVERFLOW
+    if (abandoned_blocks != NULL) {
+        (void) release_abandoned_blocks(context);
+    }
+#endif
 
     /* advance the block to the next stage */
     block->stage++;
 
+#ifdef EXCEPTIONS4C_DEADLINES
+    /* the deadline only applies to the code being tried; expired outer deadlines will not be caught by this block */
+    if (block->deadline) {
+        stop_deadline(block);
+    }
+#endif
+
     struct e4c_exception * exception = block->exception;
     const bool uncaught = block->uncaught;
 
@@ -173,6 +1043,11 @@ bool e4c_next(const char * file, const int line, const char * function) {
         block->stage++;
     }
 
+    if (is_registered(context)) {
+        watch(context, block, false, file, line, function);
+        count(context, block->stage < DONE ? 0 : -1, 0);
+    }
+
     /* carry on until the block is DONE */
     if (block->stage < DONE) {
         return true;
@@ -180,7 +1055,9 @@ bool e4c_next(const char * file, const int line, const char * function) {
 
     /* deallocate this block and promote its outer block to be the current one */
     context->_innermost_block = block->outer_block;
+    e4c_defer_deadlines();
     free(block);
+    e4c_resume_deadlines();
 
     /* deallocate or propagate its exception, depending on whether it was caught */
     if (exception != NULL) {
@@ -191,6 +1068,13 @@ bool e4c_next(const char * file, const int line, const char * function) {
         }
     }
 
+#ifdef EXCEPTIONS4C_DEADLINES
+    /* deliver any outer deadline that expired while this block was catching or finalizing */
+    if (is_deadline_timer_armed && is_deadline_exceeded(context)) {
+        throw_from_signal(context, &DEADLINE_EXCEEDED, "DEADLINE_EXCEEDED", ERROR_NUMBER, file, line, function, NULL, NULL);
+    }
+#endif
+
     /* get out of the loop */
     return false;
 }
@@ -208,6 +1092,21 @@ bool e4c_try(const char * file, const int line, const char * function) {
     return get_stage(file, line, function) == TRYING;
 }
 
+bool e4c_try_within(const long milliseconds, const char * file, const int line, const char * function) {
+    if (get_stage(file, line, function) != TRYING) {
+        return false;
+    }
+#ifdef EXCEPTIONS4C_DEADLINES
+    struct e4c_block * block = get_context(file, line, function)->_innermost_block;
+    if (!block->deadline) {
+        start_deadline(block, milliseconds, file, line, function);
+    }
+#else
+    (void) milliseconds;
+#endif
+    return true;
+}
+
 bool e4c_dispose(const char * file, const int line, const char * function) {
     return get_stage(file, line, function) == DISPOSING;
 }
@@ -228,18 +1127,80 @@ bool e4c_catch(const struct e4c_exception_type * type, const char * file, const
     return false;
 }
 
-bool e4c_finally(const char * file, const int line, const char * function) {
-    return get_stage(file, line, function) == FINALIZING;
-}
-
-e4c_env * e4c_throw( /* NOSONAR */
-    const struct e4c_exception_type * type, const char * name,
-    const char * file, const int line, const char * function,
-    const char * format, ...) {
-    const int error_number = errno;
+bool e4c_catch_any(const struct e4c_exception_type * const types[], const int count, const char * file, const int line, const char * function) {
     const struct e4c_context * context = get_context(file, line, function);
-
-    va_list arguments_list;
+    struct e4c_block * block = context->_innermost_block;
+    if (block == NULL) {
+        panic("Invalid exception context state.", file, line, function);
+    }
+    if (block->stage != CATCHING || block->exception == NULL || !block->uncaught) {
+        return false;
+    }
+    /* just like a NULL type passed to e4c_catch, a NULL type handles any exception */
+    for (int index = 0; index < count; index++) {
+        if (types[index] == NULL) {
+            block->uncaught = false;
+            return true;
+        }
+    }
+    const struct e4c_exception_type * type = block->exception->type;
+    if (type != NULL && type->display != NULL && type->display->ancestors != NULL) {
+        /* the exception type is registered; check each supplied type in constant time, if registered too */
+        for (int index = 0; index < count; index++) {
+            if (extends(type, types[index])) {
+                block->uncaught = false;
+                return true;
+            }
+        }
+        return false;
+    }
+    /* walk through the supertypes of the exception once, comparing each one against all the supplied types */
+    for (; type != NULL; type = type != type->supertype ? type->supertype : NULL) {
+        /* branch-free, so that the compiler can vectorize long lists of types */
+        bool found = false;
+        for (int index = 0; index < count; index++) {
+            found |= types[index] == type;
+        }
+        if (found) {
+            block->uncaught = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool e4c_catch_family(const struct e4c_exception_family * family, const char * file, const int line, const char * function) {
+    const struct e4c_context * context = get_context(file, line, function);
+    struct e4c_block * block = context->_innermost_block;
+    if (block == NULL) {
+        panic("Invalid exception context state.", file, line, function);
+    }
+    if (block->stage == CATCHING
+        && block->exception != NULL && block->uncaught
+        && get_family_id(family, block->exception->type) != 0) {
+        block->uncaught = false;
+        return true;
+    }
+    return false;
+}
+
+int e4c_get_exception_id(const struct e4c_exception_family * family) {
+    const struct e4c_exception * exception = e4c_get_exception();
+    return exception != NULL ? get_family_id(family, exception->type) : 0;
+}
+
+bool e4c_finally(const char * file, const int line, const char * function) {
+    return get_stage(file, line, function) == FINALIZING;
+}
+
+e4c_env * e4c_throw( /* NOSONAR */
+    const struct e4c_exception_type * type, const char * name,
+    const char * file, const int line, const char * function,
+    const char * format, ...) {
+    const int error_number = ERROR_NUMBER;
+    const struct e4c_context * context = get_context(file, line, function);
+
+    va_list arguments_list;
     va_start(arguments_list, format);
     throw(context, type, name, error_number, file, line, function, format, arguments_list);
     va_end(arguments_list);
@@ -247,40 +1208,204 @@ e4c_env * e4c_throw( /* NOSONAR */
     return &((struct e4c_block *) context->_innermost_block)->env;
 }
 
+e4c_env * e4c_throw_from_signal(
+    const struct e4c_exception_type * type, const char * name,
+    const char * file, const int line, const char * function,
+    const char * message) {
+    const int error_number = ERROR_NUMBER;
+    const struct e4c_context * context = get_signal_context();
+    if (context == NULL) {
+        panic("Exception context not created before throwing from a signal handler.", file, line, function);
+    }
+    throw_from_signal(context, type, name, error_number, file, line, function, message, NULL);
+    return &((struct e4c_block *) context->_innermost_block)->env;
+}
+
+/**
+ * Throws a preallocated exception from a signal handler.
+ *
+ * @param context the current exception context.
+ * @param type the type of exception to throw.
+ * @param name the name of the exception type.
+ * @param error_number the value of errno when the exception was thrown.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @param message the error message, which will not be formatted.
+ * @param info a possibly-null pointer to the signal the exception is thrown from.
+ */
+static void throw_from_signal( /* NOSONAR */
+    const struct e4c_context * context,
+    const struct e4c_exception_type * type, const char * name, const int error_number,
+    const char * file, const int line, const char * function,
+    const char * message, const struct e4c_signal_info * info) {
+
+    /* take a preallocated exception instead of allocating a new one */
+    struct signal_slot * slot = NULL;
+    for (int index = 0; index < EXCEPTIONS4C_SIGNAL_SLOTS && slot == NULL; index++) {
+        if (!atomic_exchange_explicit(&signal_slots[index].in_use, true, memory_order_acquire)) {
+            slot = &signal_slots[index];
+        }
+    }
+    if (slot == NULL) {
+        panic("No exception slot left to throw from a signal handler.", file, line, function);
+    }
+
+    struct e4c_exception * exception = &slot->exception;
+    exception->name         = name;
+    exception->type         = type;
+    exception->cause        = NULL;
+#ifndef EXCEPTIONS4C_NO_DEBUG_INFO
+    exception->file         = file;
+    exception->line         = line;
+    exception->function     = function;
+#endif
+#ifndef EXCEPTIONS4C_NO_ERRNO
+    exception->error_number = error_number;
+#else
+    (void) error_number;
+#endif
+#ifndef EXCEPTIONS4C_NO_HOOKS
+    exception->data         = NULL;
+#endif
+    exception->_allocation  = (void *) &signal_allocation;
+    slot->suppressed        = NULL;
+    if (info != NULL) {
+        slot->info = *info;
+    } else {
+        slot->info = (struct e4c_signal_info) {0};
+    }
+
+    /* copy the message without formatting it */
+    if (message == NULL && type != NULL) {
+        message = type->default_message;
+    }
+    size_t length = 0;
+    for (; message != NULL && message[length] != '\0' && length + 1 < sizeof(exception->message); length++) {
+        exception->message[length] = message[length];
+    }
+    exception->message[length] = '\0';
+
+    capture_cause(context, exception);
+
+    /* exceptions cannot be deleted in a signal handler, so the one that would be suppressed is deleted later */
+    struct e4c_block * block = context->_innermost_block;
+    if (block != NULL && block->exception != NULL) {
+        slot->suppressed = block->exception;
+        block->exception = NULL;
+    }
+
+    if (is_registered(context)) {
+        count(context, 0, +1);
+    }
+    propagate(context, exception);
+}
+
+e4c_env * e4c_rethrow_captured(struct e4c_exception * exception, const char * file, const int line, const char * function) {
+    const struct e4c_context * context = get_context(file, line, function);
+    if (exception == NULL) {
+        panic("Captured exception is NULL.", file, line, function);
+    }
+    for (struct e4c_exception * cause = exception; cause != NULL; cause = cause->cause) {
+#ifndef EXCEPTIONS4C_NO_HOOKS
+        if (context->initialize_exception != NULL) {
+            context->initialize_exception(cause);
+        }
+#endif
+        if (is_registered(context)) {
+            count(context, 0, +1);
+        }
+    }
+    propagate(context, exception);
+    return &((struct e4c_block *) context->_innermost_block)->env;
+}
+
+#ifndef EXCEPTIONS4C_NO_RETRY
+
 e4c_env * e4c_restart( /* NOSONAR */
     const bool should_reacquire, const int max_attempts,
     const struct e4c_exception_type * type, const char * name,
     const char * file, const int line, const char * function,
     const char * format, ...) {
-    const int error_number = errno;
+    const int error_number = ERROR_NUMBER;
+    va_list arguments_list;
+    va_start(arguments_list, format);
+    e4c_env * env = restart(should_reacquire, max_attempts, NULL, type, name, error_number, file, line, function, format, arguments_list);
+    va_end(arguments_list);
+    return env;
+}
+
+e4c_env * e4c_restart_backoff( /* NOSONAR */
+    const bool should_reacquire, const int max_attempts, const struct e4c_backoff * policy,
+    const struct e4c_exception_type * type, const char * name,
+    const char * file, const int line, const char * function,
+    const char * format, ...) {
+    const int error_number = ERROR_NUMBER;
+    if (policy == NULL) {
+        panic("Backoff policy is NULL.", file, line, function);
+    }
+    va_list arguments_list;
+    va_start(arguments_list, format);
+    e4c_env * env = restart(should_reacquire, max_attempts, policy, type, name, error_number, file, line, function, format, arguments_list);
+    va_end(arguments_list);
+    return env;
+}
+
+/**
+ * Restarts the current exception block, possibly after waiting according to a backoff policy.
+ *
+ * @param should_reacquire if <tt>true</tt>, the exception block will restart in the #ACQUIRING stage; otherwise it will start in the #TRYING stage.
+ * @param max_attempts the maximum number of attempts.
+ * @param policy a possibly-null pointer to the backoff policy; if <tt>NULL</tt>, the block restarts right away.
+ * @param type the type of exception to throw.
+ * @param name the name of the exception type.
+ * @param error_number the value of <tt>errno</tt> at the time the exception block is restarted.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @param format the error message.
+ * @param arguments_list an optional list of arguments that will be formatted according to <tt>format</tt>.
+ * @return the execution context of the current exception block.
+ */
+static e4c_env * restart( /* NOSONAR */
+    const bool should_reacquire, const int max_attempts, const struct e4c_backoff * policy,
+    const struct e4c_exception_type * type, const char * name, const int error_number,
+    const char * file, const int line, const char * function,
+    const char * format, va_list arguments_list) {
     const struct e4c_context * context = get_context(file, line, function);
     struct e4c_block * block = context->_innermost_block;
     if (block == NULL) {
         panic(should_reacquire ? "No `WITH` block to reacquire." : "No `TRY` block to retry.", file, line, function);
     }
 
-    /* check if maximum number of attempts reached and update the number of attempts */
-    bool max_reached;
-    if (should_reacquire) {
-        max_reached = block->reacquire_attempts >= max_attempts;
-        if (!max_reached) {
-            block->reacquire_attempts++;
+    /* check if maximum number of attempts reached */
+    int * attempts = should_reacquire ? &block->reacquire_attempts : &block->retry_attempts;
+    bool max_reached = *attempts >= max_attempts;
+
+    /* check if waiting would exceed the time budget, then wait */
+    if (!max_reached && policy != NULL) {
+        const long long now = policy->clock != NULL ? policy->clock() : get_milliseconds();
+        const long delay = get_backoff_delay(policy, block, *attempts);
+        if (*attempts == 0) {
+            block->backoff_started = now;
         }
-    } else {
-        max_reached = block->retry_attempts >= max_attempts;
+        max_reached = policy->budget > 0 && now - block->backoff_started + delay > policy->budget;
         if (!max_reached) {
-            block->retry_attempts++;
+            block->backoff_delay = delay;
+            if (policy->sleep != NULL) {
+                policy->sleep(delay);
+            } else {
+                sleep_milliseconds(delay);
+            }
         }
     }
 
     if (max_reached) {
         /* throw a new exception, possibly using the current one as the cause of the new one */
-        va_list arguments_list;
-        va_start(arguments_list, format);
         throw(context, type, name, error_number, file, line, function, format, arguments_list);
-        va_end(arguments_list);
     } else {
         /* suppress the currently thrown exception; jump back to the TRY or WITH block */
+        (*attempts)++;
         if (block->exception != NULL) {
             delete_exception(context, block->exception);
             block->exception = NULL;
@@ -292,6 +1417,79 @@ e4c_env * e4c_restart( /* NOSONAR */
     return &block->env;
 }
 
+/**
+ * Calculates how long to wait before repeating an exception block.
+ *
+ * @param policy the backoff policy.
+ * @param block the exception block to repeat.
+ * @param attempts the number of times the exception block has been repeated so far.
+ * @return the delay, in milliseconds.
+ */
+static long get_backoff_delay(const struct e4c_backoff * policy, const struct e4c_block * block, const int attempts) {
+    const long initial_delay = policy->initial_delay > 0 ? policy->initial_delay : 0;
+    long delay = initial_delay;
+    if (policy->strategy == E4C_BACKOFF_DECORRELATED_JITTER) {
+        /* pick a random delay between the initial delay and three times the previous one */
+        const long previous_delay = attempts > 0 && block->backoff_delay > initial_delay ? block->backoff_delay : initial_delay;
+        const long upper_bound = previous_delay > LONG_MAX / 3 ? LONG_MAX : previous_delay * 3;
+        if (jitter_state == 0) {
+            jitter_state = (unsigned long long) get_nanoseconds() ^ (unsigned long long) (uintptr_t) &jitter_state;
+            jitter_state |= 1;
+        }
+        jitter_state ^= jitter_state << 13;
+        jitter_state ^= jitter_state >> 7;
+        jitter_state ^= jitter_state << 17;
+        delay += (long) (jitter_state % ((unsigned long long) (upper_bound - initial_delay) + 1));
+    } else {
+        /* double the initial delay once per attempt, until it reaches the maximum delay */
+        for (int attempt = 0; attempt < attempts && (policy->max_delay <= 0 || delay < policy->max_delay); attempt++) {
+            delay = delay > LONG_MAX / 2 ? LONG_MAX : delay * 2;
+        }
+    }
+    return policy->max_delay > 0 && delay > policy->max_delay ? policy->max_delay : delay;
+}
+
+/**
+ * Retrieves the current time of a monotonic clock, if available.
+ *
+ * @return the current time, in milliseconds.
+ */
+static long long get_milliseconds(void) {
+    return get_nanoseconds() / 1000000;
+}
+
+/**
+ * Suspends the current thread for a number of milliseconds.
+ *
+ * @param milliseconds the number of milliseconds to sleep.
+ */
+static void sleep_milliseconds(const long milliseconds) {
+    struct timespec remaining = {
+        .tv_sec = milliseconds / 1000,
+        .tv_nsec = (milliseconds % 1000) * 1000000
+    };
+#ifdef HAVE_NANOSLEEP
+    while (nanosleep(&remaining, &remaining) != 0 && errno == EINTR) {
+        /* keep sleeping after being interrupted by a signal */
+    }
+#else
+    const long long until = get_nanoseconds() + (long long) remaining.tv_sec * 1000000000 + remaining.tv_nsec;
+    while (get_nanoseconds() < until) {
+        /* busy-wait when no sleep function is available */
+    }
+#endif
+}
+
+#endif
+
+#if EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_BUILTIN
+
+__attribute__((__noinline__)) void e4c_long_jump(e4c_env * env) {
+    __builtin_longjmp(*env, 1);
+}
+
+#endif
+
 /**
  * Causes abnormal program termination due to a fatal error.
  *
@@ -318,7 +1516,9 @@ static noreturn void panic(const char * error_message, const char * file, const
  * @return a pointer to the newly allocated memory.
  */
 static void * allocate(size_t size, const char * error_message, const char * file, int line, const char * function) {
+    e4c_defer_deadlines();
     void * object = calloc(1, size);
+    e4c_resume_deadlines();
     if (object == NULL) {
         panic(error_message, file, line, function);
     }
@@ -334,6 +1534,61 @@ static void cleanup_default_context(void) {
     }
 }
 
+/**
+ * Retrieves the exception context of the current thread.
+ *
+ * The first time a thread needs it, its context is initialized with the
+ * handlers of the default context and scheduled for cleanup at thread exit.
+ * If the registry is enabled, the context is also registered, which MAY
+ * allocate a registry entry; freed entries are reused.
+ *
+ * @return a non-null pointer to the exception context of the current thread.
+ */
+static inline struct e4c_context * get_thread_context(void) {
+    if (!thread_context.initialized) {
+        thread_context.context = default_context;
+        thread_context.context._innermost_block = NULL;
+        thread_context.initialized = true;
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+        thread_context.context._cancellation_token = NULL;
+#endif
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+        thread_context.context._registry = NULL;
+        if (atomic_load_explicit(&is_registry_enabled, memory_order_relaxed)) {
+            e4c_register_context(&thread_context.context);
+        }
+#endif
+#ifdef HAVE_LIBPTHREAD
+        (void) pthread_once(&thread_cleanup_once, create_thread_cleanup_key);
+        if (pthread_setspecific(thread_cleanup_key, &thread_context.context) != 0) {
+            panic("Thread cleanup could not be scheduled.", NULL, 0, NULL);
+        }
+#endif
+    }
+    return &thread_context.context;
+}
+
+#ifdef HAVE_LIBPTHREAD
+
+/**
+ * Deletes the exception blocks and exceptions left behind by an exiting thread.
+ *
+ * @param data the exception context of the exiting thread.
+ */
+static void cleanup_thread_context(void * data) {
+    struct e4c_context * context = data;
+    (void) e4c_context_reset(context);
+#ifdef EXCEPTIONS4C_STACK_OVERFLOW
+    (void) release_abandoned_blocks(context);
+#endif
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+    e4c_unregister_context(context);
+#endif
+    thread_context.initialized = false;
+}
+
+#endif
+
 /**
  * Retrieves the current exception context; <em>panics</em> if <tt>NULL</tt>.
  *
@@ -350,6 +1605,21 @@ static struct e4c_context * get_context(const char * file, const int line, const
     return context;
 }
 
+/**
+ * Retrieves the current exception context from a signal handler, without creating the context of the current thread.
+ *
+ * Creating the context of a thread may allocate memory, which is not async-signal-safe. A thread whose context has not
+ * been created yet cannot have any exception blocks open anyway.
+ *
+ * @return a possibly-null pointer to the current exception context.
+ */
+static struct e4c_context * get_signal_context(void) {
+    if (active_context == NULL && context_supplier == e4c_thread_context && !thread_context.initialized) {
+        return NULL;
+    }
+    return e4c_get_context();
+}
+
 /**
  * Propagates the supplied exception in the supplied context.
  *
@@ -363,19 +1633,24 @@ static void propagate(const struct e4c_context * context, struct e4c_exception *
     struct e4c_block * block = context->_innermost_block;
     if (block == NULL) {
         /* uncaught exception handler */
+#ifndef EXCEPTIONS4C_NO_HOOKS
         if (context->uncaught_handler != NULL) {
             context->uncaught_handler(exception);
-        } else {
+        } else
+#endif
+        {
             print_exception(exception, false);
             (void) fflush(stderr);
         }
         /* delete the exception to avoid memory leaks */
         delete_exception(context, exception);
         /* abrupt termination handler */
+#ifndef EXCEPTIONS4C_NO_HOOKS
         if (context->termination_handler != NULL) {
             context->termination_handler();
             return;
         }
+#endif
         exit(EXIT_FAILURE);
     }
 
@@ -413,12 +1688,21 @@ static enum block_stage get_stage(const char * file, const int line, const char
 }
 
 /**
+ * Checks if an exception type extends another one.
  *
- * @param type
- * @param supertype
- * @return
+ * @param type the exception type to check.
+ * @param supertype the possible supertype.
+ * @return <tt>true</tt> if <tt>type</tt> is <tt>supertype</tt> or any of its subtypes.
+ *
+ * @note
+ * If both exception types have been [registered](#e4c_register_type), this check takes constant time.
  */
 static bool extends(const struct e4c_exception_type * type, const struct e4c_exception_type * supertype) {
+    const struct e4c_type_display * display = type != NULL ? type->display : NULL;
+    const struct e4c_type_display * super_display = supertype->display;
+    if (display != NULL && display->ancestors != NULL && super_display != NULL && super_display->ancestors != NULL) {
+        return super_display->depth <= display->depth && display->ancestors[super_display->depth] == supertype;
+    }
     for (; type != NULL; type = type != type->supertype ? type->supertype : NULL) {
         if (type == supertype) {
             return true;
@@ -427,6 +1711,22 @@ static bool extends(const struct e4c_exception_type * type, const struct e4c_exc
     return false;
 }
 
+/**
+ * Finds the identifier of an exception type (or its closest supertype) within a family.
+ *
+ * @param family the family of exception types.
+ * @param type the exception type.
+ * @return the identifier of the exception type or its closest supertype, or zero if none of them belongs to the family.
+ */
+static int get_family_id(const struct e4c_exception_family * family, const struct e4c_exception_type * type) {
+    for (; type != NULL; type = type != type->supertype ? type->supertype : NULL) {
+        if (type->id > 0 && type->id < family->count && family->types[type->id] == type) {
+            return type->id;
+        }
+    }
+    return 0;
+}
+
 /**
  *
  * @param context
@@ -450,37 +1750,590 @@ static void throw( /* NOSONAR */
 
     /* "instantiate" the specified exception */
     exception->name         = name;
+    exception->type         = type;
+    exception->cause        = NULL;
+#ifndef EXCEPTIONS4C_NO_DEBUG_INFO
     exception->file         = file;
     exception->line         = line;
     exception->function     = function;
+#endif
+#ifndef EXCEPTIONS4C_NO_ERRNO
     exception->error_number = error_number;
-    exception->type         = type;
-    exception->cause        = NULL;
+#else
+    (void) error_number;
+#endif
+#ifndef EXCEPTIONS4C_NO_HOOKS
     exception->data         = NULL;
+#endif
+    exception->_allocation  = NULL;
 
+    e4c_defer_deadlines();
     if (format == NULL && type != NULL) {
         (void) snprintf(exception->message, sizeof(exception->message), "%s", type->default_message);
     } else if (format != NULL) {
         (void) vsnprintf(exception->message, sizeof(exception->message), format, arguments_list); /* NOSONAR */
     }
 
-    /* capture the cause of this exception */
-    for (struct e4c_block * block = context->_innermost_block; block != NULL; block = block->outer_block) {
-        if (block->exception != NULL && (block->uncaught || block->stage == CATCHING)) {
-            exception->cause = block->exception;
-            block->exception = NULL;
-            break;
-        }
-    }
+    capture_cause(context, exception);
 
     /* initialize custom data */
+#ifndef EXCEPTIONS4C_NO_HOOKS
     if (context->initialize_exception != NULL) {
         context->initialize_exception(exception);
     }
+#endif
+    e4c_resume_deadlines();
+
+    if (is_registered(context)) {
+        count(context, 0, +1);
+    }
 
     propagate(context, exception);
 }
 
+/**
+ * Throws a #MAPPED_IO_ERROR after an access to a probed memory region was interrupted by a signal.
+ *
+ * The exception blocks that were started inside the probed region are discarded, since their functions were exited
+ * abruptly.
+ *
+ * @param probe the probed memory region.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @return the execution context of the current exception block.
+ */
+static e4c_env * probe_fail(const struct e4c_probe * probe, const char * file, const int line, const char * function) {
+    const int error_number = ERROR_NUMBER;
+    struct e4c_context * context = get_context(file, line, function);
+
+    while (context->_innermost_block != NULL) {
+        struct e4c_block * block = context->_innermost_block;
+        const struct e4c_probe * block_probe = block->probe;
+        while (block_probe != NULL && block_probe != probe) {
+            block_probe = block_probe->_outer;
+        }
+        if (block_probe == NULL) {
+            break;
+        }
+        context->_innermost_block = block->outer_block;
+        delete_block(context, block);
+    }
+
+    char message[64];
+    (void) snprintf(message, sizeof(message), "Mapped memory could not be accessed at offset %zu", probe->_info.offset);
+    throw_from_signal(context, &MAPPED_IO_ERROR, "MAPPED_IO_ERROR", error_number, file, line, function, message, &probe->_info);
+    return &((struct e4c_block *) context->_innermost_block)->env;
+}
+
+#ifdef EXCEPTIONS4C_SIGNAL_MAPPING
+
+/**
+ * Handles a signal, throwing the exception it is mapped to.
+ *
+ * If stack overflows are handled in the current thread, a SIGSEGV close to the end of the stack throws
+ * #STACK_OVERFLOW instead, to the innermost exception block that has enough stack space left to handle it. The blocks
+ * below it are abandoned, and deleted later, outside the signal handler. Signals that cannot be thrown are forwarded to
+ * their previous action.
+ *
+ * @param signal_number the number of the signal.
+ * @param info information about the signal.
+ * @param ucontext the execution context that was interrupted.
+ */
+static void handle_signal(const int signal_number, siginfo_t * info, void * ucontext) {
+    const int error_number = ERROR_NUMBER;
+    struct e4c_context * context = get_signal_context();
+    const struct e4c_exception_type * type = signal_mappings[signal_number].exception_type;
+    const char * name = signal_mappings[signal_number].name;
+    struct e4c_block * target = context != NULL ? context->_innermost_block : NULL;
+    const char * address = info->si_addr;
+
+    /* resume right after the probed memory region the faulting address belongs to */
+    if (signal_number == SIGBUS || signal_number == SIGSEGV) {
+        for (struct e4c_probe * probe = active_probe; probe != NULL; probe = probe->_outer) {
+            const char * base = (const char *) probe->_base;
+            if (address >= base && address < base + probe->_size) {
+                probe->_info.signal_number  = signal_number;
+                probe->_info.code           = info->si_code;
+                probe->_info.address        = info->si_addr;
+                probe->_info.offset         = (size_t) (address - base);
+                unblock_signal(signal_number);
+                EXCEPTIONS4C_LONG_JUMP(&probe->_env);
+            }
+        }
+    }
+
+#ifdef EXCEPTIONS4C_STACK_OVERFLOW
+    /* the faulting address is close to the end of the stack, either in the guard page or right before it */
+    if (signal_number == SIGSEGV && context != NULL && stack_limit != NULL
+        && address >= stack_limit - EXCEPTIONS4C_STACK_OVERFLOW_MARGIN
+        && address < stack_limit + EXCEPTIONS4C_STACK_OVERFLOW_MARGIN) {
+        type = &STACK_OVERFLOW;
+        name = "STACK_OVERFLOW";
+        target = find_overflow_target(context);
+        if (target != NULL) {
+            abandon_blocks(context, target);
+        }
+    }
+#endif
+
+    if (type == NULL || target == NULL) {
+        forward_signal(&previous_actions[signal_number], signal_number, info, ucontext);
+        return;
+    }
+
+    unblock_signal(signal_number);
+
+    const struct e4c_signal_info signal_info = {
+        .signal_number  = signal_number,
+        .code           = info->si_code,
+        .address        = info->si_addr
+    };
+    throw_from_signal(context, type, name, error_number, NULL, 0, NULL, NULL, &signal_info);
+    EXCEPTIONS4C_LONG_JUMP(&((struct e4c_block *) context->_innermost_block)->env);
+}
+
+/**
+ * Lets the signal being handled be delivered again, even though the execution context to jump to may not restore
+ * the signal mask.
+ *
+ * @param signal_number the number of the signal.
+ */
+static void unblock_signal(const int signal_number) {
+    sigset_t signals;
+    (void) sigemptyset(&signals);
+    (void) sigaddset(&signals, signal_number);
+#ifdef HAVE_LIBPTHREAD
+    (void) pthread_sigmask(SIG_UNBLOCK, &signals, NULL);
+#else
+    (void) sigprocmask(SIG_UNBLOCK, &signals, NULL);
+#endif
+}
+
+/**
+ * Forwards a signal that cannot be thrown to the action that was in place before it was handled.
+ *
+ * @param previous the action that was in place before the signal was handled.
+ * @param signal_number the number of the signal.
+ * @param info information about the signal.
+ * @param ucontext the execution context that was interrupted.
+ */
+static void forward_signal(const struct sigaction * previous, const int signal_number, siginfo_t * info, void * ucontext) {
+    if (previous->sa_flags & SA_SIGINFO) {
+        previous->sa_sigaction(signal_number, info, ucontext);
+    } else if (previous->sa_handler == SIG_DFL) {
+        /* the signal is delivered again when the handler returns, and the default action takes place */
+        (void) signal(signal_number, SIG_DFL);
+        (void) raise(signal_number);
+    } else if (previous->sa_handler != SIG_IGN) {
+        previous->sa_handler(signal_number);
+    }
+}
+
+/**
+ * Installs the handler that turns the supplied signal into exceptions.
+ *
+ * @param signal_number the number of the signal.
+ * @return whether the handler was installed.
+ */
+static bool install_signal_handler(const int signal_number) {
+    struct sigaction action = {0};
+    struct sigaction previous;
+    action.sa_sigaction = handle_signal;
+    action.sa_flags = SA_SIGINFO;
+#ifdef SA_ONSTACK
+    action.sa_flags |= SA_ONSTACK;
+#endif
+    (void) sigemptyset(&action.sa_mask);
+    if (sigaction(signal_number, &action, &previous) != 0) {
+        return false;
+    }
+    /* keep the original action when the handler is installed again */
+    if (!(previous.sa_flags & SA_SIGINFO) || previous.sa_sigaction != handle_signal) {
+        previous_actions[signal_number] = previous;
+    }
+    return true;
+}
+
+#endif
+
+#ifdef EXCEPTIONS4C_STACK_OVERFLOW
+
+/**
+ * Determines whether an address of the stack is too close to the end of the stack of the current thread.
+ *
+ * Addresses outside the stack of the current thread, such as the ones of fibers running on stacks of their own, are
+ * never too close.
+ *
+ * @param address the address.
+ * @return whether the address is within the margin left to handle stack overflows.
+ */
+static bool is_close_to_stack_limit(const void * address) {
+    return stack_limit != NULL
+        && (const char *) address >= stack_limit
+        && (const char *) address < stack_limit + EXCEPTIONS4C_STACK_OVERFLOW_MARGIN;
+}
+
+/**
+ * Finds the innermost exception block that has enough stack space left to handle a stack overflow.
+ *
+ * @param context the context of the current thread.
+ * @return a possibly-null pointer to the exception block.
+ */
+static struct e4c_block * find_overflow_target(const struct e4c_context * context) {
+    struct e4c_block * target = context->_innermost_block;
+    while (target != NULL && is_close_to_stack_limit(target->stack)) {
+        target = target->outer_block;
+    }
+    return target;
+}
+
+/**
+ * Abandons the exception blocks below the supplied one, whose stack frames are too close to the end of the stack.
+ *
+ * Abandoned blocks are not deleted right away, since this function may be called from a signal handler.
+ *
+ * @param context the context of the current thread.
+ * @param target the exception block that will become the innermost one.
+ */
+static void abandon_blocks(struct e4c_context * context, struct e4c_block * target) {
+    struct e4c_block * innermost = context->_innermost_block;
+    if (innermost != target) {
+        struct e4c_block * last = innermost;
+        while (last->outer_block != target) {
+            last = last->outer_block;
+        }
+        last->outer_block = abandoned_blocks;
+        abandoned_blocks = innermost;
+        context->_innermost_block = target;
+    }
+}
+
+/** Installs the handler for SIGSEGV that detects stack overflows. */
+static void install_segfault_handler(void) {
+    is_segfault_handler_installed = install_signal_handler(SIGSEGV);
+}
+
+/** Creates the thread-specific key that deletes alternate signal stacks. */
+static void create_alternate_stack_key(void) {
+    if (pthread_key_create(&alternate_stack_key, delete_alternate_stack) != 0) {
+        panic("Thread cleanup key could not be created.", NULL, 0, NULL);
+    }
+}
+
+/**
+ * Disables and deletes the alternate signal stack of the current thread.
+ *
+ * @param stack the alternate signal stack.
+ */
+static void delete_alternate_stack(void * stack) {
+    const stack_t disabled = {.ss_flags = SS_DISABLE};
+    (void) sigaltstack(&disabled, NULL);
+    free(stack);
+    stack_limit = NULL;
+}
+
+/**
+ * Deletes the exception blocks abandoned by stack overflows in the current thread.
+ *
+ * @param context the context the abandoned blocks belong to.
+ * @return the number of deleted blocks.
+ */
+static int release_abandoned_blocks(const struct e4c_context * context) {
+    int released = 0;
+    while (abandoned_blocks != NULL) {
+        struct e4c_block * block = abandoned_blocks;
+        abandoned_blocks = block->outer_block;
+        delete_block(context, block);
+        released++;
+    }
+    return released;
+}
+
+#endif
+
+/**
+ * Deletes an exception block that was exited abruptly, along with its exception.
+ *
+ * @param context the context the exception block belongs to.
+ * @param block the exception block to delete.
+ */
+static void delete_block(const struct e4c_context * context, struct e4c_block * block) {
+    block->stage = DONE;
+    if (is_registered(context)) {
+        watch(context, block, false, NULL, 0, NULL);
+        count(context, -1, 0);
+    }
+    if (block->exception != NULL) {
+        delete_exception(context, block->exception);
+    }
+    e4c_defer_deadlines();
+    free(block);
+    e4c_resume_deadlines();
+}
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+
+/**
+ * Cancels the tokens derived from a cancellation token.
+ *
+ * This function never waits, so that tokens can be cancelled from signal handlers. If the derived tokens are being
+ * changed right now, they are cancelled by #finish_changing_derived_tokens instead.
+ *
+ * @param token the cancellation token that was cancelled.
+ * @param reason the reason why the token was cancelled.
+ */
+static void propagate_cancellation(struct e4c_cancellation_token * token, const char * reason) {
+    int state = atomic_load(DERIVED_TOKENS_STATE(token));
+    do {
+        if (state == DERIVED_TOKENS_CHANGING) {
+            return;
+        }
+    } while (!atomic_compare_exchange_weak(DERIVED_TOKENS_STATE(token), &state, state + 1));
+    for (struct e4c_cancellation_token * child = token->_children; child != NULL; child = child->_sibling) {
+        (void) e4c_cancel(child, reason);
+    }
+    (void) atomic_fetch_sub(DERIVED_TOKENS_STATE(token), 1);
+}
+
+/**
+ * Waits until no derived tokens are being cancelled, and keeps them from being cancelled while they are changed.
+ *
+ * @param token the cancellation token whose derived tokens will be changed.
+ */
+static void start_changing_derived_tokens(struct e4c_cancellation_token * token) {
+    int state = 0;
+    while (!atomic_compare_exchange_weak(DERIVED_TOKENS_STATE(token), &state, DERIVED_TOKENS_CHANGING)) {
+        state = 0;
+    }
+}
+
+/**
+ * Lets derived tokens be cancelled again, and cancels them if the token was cancelled in the meantime.
+ *
+ * @param token the cancellation token whose derived tokens were changed.
+ */
+static void finish_changing_derived_tokens(struct e4c_cancellation_token * token) {
+    atomic_store(DERIVED_TOKENS_STATE(token), 0);
+    const char * reason = atomic_load(CANCELLATION_REASON(token));
+    if (reason != NULL) {
+        propagate_cancellation(token, reason);
+    }
+}
+
+#endif
+
+#ifdef EXCEPTIONS4C_DEADLINES
+
+/**
+ * Starts the deadline of an exception block.
+ *
+ * @param block the exception block.
+ * @param milliseconds the time the block is allowed to run.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ */
+static void start_deadline(struct e4c_block * block, const long milliseconds, const char * file, const int line, const char * function) {
+    (void) pthread_once(&deadline_once, create_deadline_key);
+    if (!is_deadline_handler_installed) {
+        panic("Deadline signal handler could not be installed.", file, line, function);
+    }
+    if (!is_deadline_timer_created) {
+        struct sigevent event = {0};
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = EXCEPTIONS4C_DEADLINE_SIGNAL;
+        /* tells the signals sent by deadline timers apart from the ones sent by anybody else */
+        event.sigev_value.sival_ptr = &deadline_key;
+        event.sigev_notify_thread_id = (pid_t) syscall(SYS_gettid);
+        if (timer_create(CLOCK_MONOTONIC, &event, &deadline_timer) != 0) {
+            panic("Deadline timer could not be created.", file, line, function);
+        }
+        (void) pthread_setspecific(deadline_key, &deadline_timer);
+        is_deadline_timer_created = true;
+    }
+    struct timespec expiration;
+    (void) clock_gettime(CLOCK_MONOTONIC, &expiration);
+    expiration.tv_sec += milliseconds / 1000;
+    expiration.tv_nsec += (milliseconds % 1000) * 1000000;
+    if (expiration.tv_nsec >= 1000000000) {
+        expiration.tv_sec++;
+        expiration.tv_nsec -= 1000000000;
+    }
+
+    /* nested deadlines cannot extend the outer ones */
+    const struct e4c_block * outer_deadline = find_deadline(block->outer_block);
+    const struct timespec * outer = outer_deadline != NULL ? &outer_deadline->expiration : NULL;
+    const bool is_earlier = outer == NULL || expiration.tv_sec < outer->tv_sec
+        || (expiration.tv_sec == outer->tv_sec && expiration.tv_nsec < outer->tv_nsec);
+    block->expiration = is_earlier ? expiration : *outer;
+    block->deadline = true;
+    if (is_earlier) {
+        set_deadline_timer(&expiration);
+    }
+}
+
+/**
+ * Stops the deadline of the innermost exception block.
+ *
+ * @param block the exception block.
+ */
+static void stop_deadline(struct e4c_block * block) {
+    block->deadline = false;
+    /* the timer is rearmed even if the outer deadline is the same, since it may have expired already */
+    const struct e4c_block * outer = find_deadline(block->outer_block);
+    set_deadline_timer(outer != NULL ? &outer->expiration : NULL);
+}
+
+/**
+ * Arms or disarms the deadline timer of the current thread.
+ *
+ * @param expiration a possibly-null pointer to the moment the timer expires; if <tt>NULL</tt>, the timer is disarmed.
+ */
+static void set_deadline_timer(const struct timespec * expiration) {
+    struct itimerspec setting = {0};
+    if (expiration != NULL) {
+        setting.it_value = *expiration;
+    }
+    is_deadline_timer_armed = expiration != NULL;
+    (void) timer_settime(deadline_timer, TIMER_ABSTIME, &setting, NULL);
+}
+
+/**
+ * Finds the innermost exception block that is running against a deadline.
+ *
+ * Deadlines belong to the exception blocks that set them, so that deleting the blocks of a context never leaves a
+ * deadline behind; at most, the timer of the thread expires spuriously.
+ *
+ * @param block a possibly-null pointer to the exception block to start looking from.
+ * @return a possibly-null pointer to the exception block.
+ */
+static const struct e4c_block * find_deadline(const struct e4c_block * block) {
+    while (block != NULL && !block->deadline) {
+        block = block->outer_block;
+    }
+    return block;
+}
+
+/**
+ * Determines whether a deadline has expired.
+ *
+ * @param expiration the moment the deadline expires.
+ * @return whether the moment has passed.
+ */
+static bool has_expired(const struct timespec * expiration) {
+    struct timespec now;
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+        return false;
+    }
+    return now.tv_sec > expiration->tv_sec || (now.tv_sec == expiration->tv_sec && now.tv_nsec >= expiration->tv_nsec);
+}
+
+/**
+ * Determines whether the innermost deadline has expired and can be delivered to the current block.
+ *
+ * Expired deadlines are not delivered while the innermost block is catching or finalizing, so that they are not
+ * caught by blocks inside the one that set them; #e4c_next delivers them once the innermost block is done.
+ *
+ * @param context the current exception context.
+ * @return whether #DEADLINE_EXCEEDED should be thrown.
+ */
+static bool is_deadline_exceeded(const struct e4c_context * context) {
+    const struct e4c_block * block = context != NULL ? context->_innermost_block : NULL;
+    const struct e4c_block * deadline = find_deadline(block);
+    return deadline != NULL && block->stage == TRYING && has_expired(&deadline->expiration);
+}
+
+/**
+ * Handles the expiration of a deadline, throwing #DEADLINE_EXCEEDED.
+ *
+ * If the innermost deadline has not expired yet, the timer is rearmed for it, since the signal may have been sent for
+ * a deadline that is gone, or before the timer was rearmed. Signals that were not sent by a deadline timer are
+ * forwarded to the action that was in place before the handler was installed.
+ *
+ * @param signal_number the number of the signal.
+ * @param info information about the signal.
+ * @param ucontext the execution context that was interrupted.
+ */
+static void handle_deadline(const int signal_number, siginfo_t * info, void * ucontext) {
+    if (info->si_code != SI_TIMER || info->si_value.sival_ptr != &deadline_key) {
+        forward_signal(&previous_deadline_action, signal_number, info, ucontext);
+        return;
+    }
+    const int error_number = ERROR_NUMBER;
+    const struct e4c_context * context = get_signal_context();
+    const struct e4c_block * deadline = find_deadline(context != NULL ? context->_innermost_block : NULL);
+    if (deadline == NULL) {
+        /* the block that set the deadline was deleted */
+        return;
+    }
+    if (!has_expired(&deadline->expiration)) {
+        /* the timer was armed for a deadline that is gone, or was rearmed after the signal was sent */
+        set_deadline_timer(&deadline->expiration);
+        return;
+    }
+    if (!is_deadline_exceeded(context)) {
+        return;
+    }
+    if (uninterruptible_calls > 0) {
+        /* library code may be allocating memory, so it cannot be jumped out of; try again shortly */
+        struct timespec retry;
+        (void) clock_gettime(CLOCK_MONOTONIC, &retry);
+        retry.tv_nsec += EXCEPTIONS4C_DEADLINE_RETRY * 1000000L;
+        retry.tv_sec += retry.tv_nsec / 1000000000;
+        retry.tv_nsec %= 1000000000;
+        set_deadline_timer(&retry);
+        return;
+    }
+    unblock_signal(signal_number);
+    throw_from_signal(context, &DEADLINE_EXCEEDED, "DEADLINE_EXCEEDED", error_number, NULL, 0, NULL, NULL, NULL);
+    EXCEPTIONS4C_LONG_JUMP(&((struct e4c_block *) context->_innermost_block)->env);
+}
+
+/** Installs the handler for the deadline signal and creates the thread-specific key that deletes deadline timers. */
+static void create_deadline_key(void) {
+    if (pthread_key_create(&deadline_key, delete_deadline_timer) != 0) {
+        panic("Thread cleanup key could not be created.", NULL, 0, NULL);
+    }
+    struct sigaction action = {0};
+    action.sa_sigaction = handle_deadline;
+    action.sa_flags = SA_SIGINFO;
+#ifdef SA_ONSTACK
+    action.sa_flags |= SA_ONSTACK;
+#endif
+    (void) sigemptyset(&action.sa_mask);
+    is_deadline_handler_installed = sigaction(EXCEPTIONS4C_DEADLINE_SIGNAL, &action, &previous_deadline_action) == 0;
+}
+
+/**
+ * Deletes the deadline timer of the current thread.
+ *
+ * @param timer the deadline timer.
+ */
+static void delete_deadline_timer(void * timer) {
+    (void) timer_delete(*(timer_t *) timer);
+    is_deadline_timer_created = false;
+    is_deadline_timer_armed = false;
+}
+
+#endif
+
+/**
+ * Captures the cause of a new exception: the exception being handled, if any.
+ *
+ * @param context the context the new exception will be thrown in.
+ * @param exception the new exception.
+ */
+static void capture_cause(const struct e4c_context * context, struct e4c_exception * exception) {
+    for (struct e4c_block * block = context->_innermost_block; block != NULL; block = block->outer_block) {
+        if (block->exception != NULL && (block->uncaught || block->stage == CATCHING)) {
+            exception->cause = block->exception;
+            block->exception = NULL;
+            break;
+        }
+    }
+}
+
 /**
  * Deletes the supplied exception, along with its cause.
  *
@@ -488,15 +2341,192 @@ static void throw( /* NOSONAR */
  * @param exception the exception to delete.
  */
 static void delete_exception(const struct e4c_context * context, struct e4c_exception * exception) {
+    e4c_defer_deadlines();
+#ifndef EXCEPTIONS4C_NO_HOOKS
     if (context->finalize_exception != NULL) {
         context->finalize_exception(exception);
     }
+#else
+    (void) context;
+#endif
     if (exception->cause != NULL) {
         delete_exception(context, exception->cause);
     }
-    free(exception);
+    /* captured exceptions share one block of memory, which starts with the outermost one */
+    if (exception->_allocation == &signal_allocation) {
+        struct signal_slot * slot = (struct signal_slot *) exception;
+        struct e4c_exception * suppressed = slot->suppressed;
+        atomic_store_explicit(&slot->in_use, false, memory_order_release);
+        if (suppressed != NULL) {
+            delete_exception(context, suppressed);
+        }
+    } else if (exception->_allocation == NULL || exception->_allocation == exception) {
+        free(exception);
+    }
+    if (is_registered(context)) {
+        count(context, 0, -1);
+    }
+    e4c_resume_deadlines();
 }
 
+/**
+ * Checks whether the supplied context is linked to the context registry.
+ *
+ * Registry bookkeeping MUST be skipped altogether when this function returns false.
+ *
+ * @param context the context to check.
+ * @return true if the supplied context is registered.
+ */
+static inline bool is_registered(const struct e4c_context * context) {
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+    return context->_registry != NULL;
+#else
+    (void) context;
+    return false;
+#endif
+}
+
+/**
+ * Updates the registry counters of the supplied context, which MUST be registered.
+ *
+ * The counters are updated atomically, since a signal handler may throw an
+ * exception while they are being updated, and a context may be attached to
+ * different threads over time.
+ *
+ * @param context the context whose counters will be updated.
+ * @param blocks the change in the number of open exception blocks.
+ * @param exceptions the change in the number of alive exceptions.
+ */
+static void count(const struct e4c_context * context, const int blocks, const int exceptions) {
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+    struct registry_entry * entry = context->_registry;
+    if (blocks != 0) {
+        (void) atomic_fetch_add_explicit(&entry->blocks, blocks, memory_order_relaxed);
+    }
+    if (exceptions != 0) {
+        (void) atomic_fetch_add_explicit(&entry->exceptions, exceptions, memory_order_relaxed);
+    }
+#else
+    (void) context;
+    (void) blocks;
+    (void) exceptions;
+#endif
+}
+
+/**
+ * Publishes the stage of an exception block, so that other threads can take snapshots of it.
+ *
+ * The supplied context MUST be registered. The clock is only read once some thread took snapshots.
+ *
+ * @param context the context the exception block belongs to.
+ * @param block the exception block.
+ * @param is_new whether the exception block has just started.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ */
+static void watch(const struct e4c_context * context, const struct e4c_block * block, const bool is_new, const char * file, const int line, const char * function) {
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+    struct registry_entry * entry = context->_registry;
+    /* the sequence is odd while the update is in progress */
+    const unsigned sequence = atomic_load_explicit(&entry->sequence, memory_order_relaxed);
+    atomic_store_explicit(&entry->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    if (block->depth <= EXCEPTIONS4C_MAX_WATCHED_BLOCKS) {
+        struct watched_block * watched = &entry->watched[block->depth - 1];
+        if (is_new) {
+            atomic_store_explicit(&watched->file, file, memory_order_relaxed);
+            atomic_store_explicit(&watched->line, line, memory_order_relaxed);
+            atomic_store_explicit(&watched->function, function, memory_order_relaxed);
+            /* reading the clock is postponed until some thread takes snapshots */
+            atomic_store_explicit(&watched->started, atomic_load_explicit(&is_watchdog_enabled, memory_order_relaxed) ? get_nanoseconds() : 0, memory_order_relaxed);
+        }
+        atomic_store_explicit(&watched->stage, (int) block->stage, memory_order_relaxed);
+    }
+    /* abandoned blocks may be deleted after newer blocks started */
+    const int depth = atomic_load_explicit(&entry->depth, memory_order_relaxed);
+    if (block->stage != DONE) {
+        atomic_store_explicit(&entry->depth, block->depth, memory_order_relaxed);
+    } else if (block->depth <= depth) {
+        atomic_store_explicit(&entry->depth, block->depth - 1, memory_order_relaxed);
+    }
+    atomic_store_explicit(&entry->sequence, sequence + 2, memory_order_release);
+#else
+    (void) context;
+    (void) block;
+    (void) is_new;
+    (void) file;
+    (void) line;
+    (void) function;
+#endif
+}
+
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+
+/**
+ * Takes a consistent snapshot of the watched blocks of a registry entry, without blocking its owner thread.
+ *
+ * @param entry the registry entry.
+ * @param snapshots the array to fill.
+ * @param max_snapshots the length of the array.
+ * @return the number of exception blocks open in the registered context.
+ */
+static int snapshot_entry(struct registry_entry * entry, struct e4c_block_snapshot snapshots[], const int max_snapshots) {
+    if (!atomic_load_explicit(&is_watchdog_enabled, memory_order_relaxed)) {
+        atomic_store_explicit(&is_watchdog_enabled, true, memory_order_relaxed);
+    }
+    const int length = max_snapshots < EXCEPTIONS4C_MAX_WATCHED_BLOCKS ? max_snapshots : EXCEPTIONS4C_MAX_WATCHED_BLOCKS;
+    long long started[EXCEPTIONS4C_MAX_WATCHED_BLOCKS];
+    unsigned sequence;
+    int depth;
+    do {
+        /* retry until the owner thread did not update the watched blocks while they were being copied */
+        do {
+            sequence = atomic_load_explicit(&entry->sequence, memory_order_acquire);
+        } while (sequence % 2 != 0);
+        depth = atomic_load_explicit(&entry->depth, memory_order_relaxed);
+        for (int index = 0; index < depth && index < length; index++) {
+            const struct watched_block * watched = &entry->watched[index];
+            snapshots[index].stage          = (enum e4c_block_stage) atomic_load_explicit(&watched->stage, memory_order_relaxed);
+            snapshots[index].file           = atomic_load_explicit(&watched->file, memory_order_relaxed);
+            snapshots[index].line           = atomic_load_explicit(&watched->line, memory_order_relaxed);
+            snapshots[index].function       = atomic_load_explicit(&watched->function, memory_order_relaxed);
+            started[index]                  = atomic_load_explicit(&watched->started, memory_order_relaxed);
+        }
+        atomic_thread_fence(memory_order_acquire);
+    } while (atomic_load_explicit(&entry->sequence, memory_order_relaxed) != sequence);
+    const long long now = get_nanoseconds();
+    for (int index = 0; index < depth && index < length; index++) {
+        /* blocks that started before any snapshot was taken are timed from the first one that sees them */
+        if (started[index] == 0 && atomic_compare_exchange_strong_explicit(&entry->watched[index].started, &started[index], now, memory_order_relaxed, memory_order_relaxed)) {
+            started[index] = now;
+        }
+        snapshots[index].milliseconds = (long) ((now - started[index]) / 1000000);
+    }
+    return depth;
+}
+
+#endif
+
+#if !defined(EXCEPTIONS4C_NO_REGISTRY) || !defined(EXCEPTIONS4C_NO_RETRY)
+
+/**
+ * Retrieves the current time of a monotonic clock, if available.
+ *
+ * @return the current time, in nanoseconds.
+ */
+static long long get_nanoseconds(void) {
+    struct timespec now = {0};
+#ifdef CLOCK_MONOTONIC
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+#else
+    (void) timespec_get(&now, TIME_UTC);
+#endif
+    return (long long) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+#endif
+
 /**
  * Prints debug info (if available) to the standard error output.
  *
@@ -518,7 +2548,9 @@ static void print_debug_info(const char * file, const int line, const char * fun
  */
 static void print_exception(const struct e4c_exception * exception, const bool is_cause) {
     (void) fprintf(stderr, "%s%s: %s\n", is_cause ? "Caused by: " : "\n", exception->name, exception->message);
+#ifndef EXCEPTIONS4C_NO_DEBUG_INFO
     print_debug_info(exception->file, exception->line, exception->function);
+#endif
     if (exception->cause != NULL) {
         print_exception(exception->cause, true);
     }
@@ -83,12 +83,114 @@ extern "C" {
  * @see CATCH
  * @see CATCH_ALL
  * @see FINALLY
+ * @see TRY_SIGNALSAFE
  */
 #define TRY                                                                 \
                                                                             \
-  EXCEPTIONS4C_START_BLOCK(false)                                           \
+  EXCEPTIONS4C_START_BLOCK(false, false)                                    \
   if (e4c_try(EXCEPTIONS4C_DEBUG))
 
+/**
+ * Introduces a block of code that may throw exceptions from a signal
+ * handler during execution.
+ *
+ * A #TRY_SIGNALSAFE block works exactly like a #TRY block, except that
+ * it also saves the signal mask of the calling thread when the block
+ * starts, and restores it when an exception is caught.
+ *
+ * A regular #TRY block does not save the signal mask, since that usually
+ * involves a system call every time the block starts. That is fine, as
+ * long as no exception is thrown from a signal handler. But when a
+ * signal handler throws an exception, the signal that is being handled
+ * remains blocked, unless the signal mask is restored.
+ *
+ * ```c
+ * e4c_map_signals(NULL, 0);
+ *
+ * TRY_SIGNALSAFE {
+ *   int oops = *null_pointer;
+ * } CATCH (SIGNAL_ERROR) {
+ *   printf("No problem ;-)");
+ * }
+ * ```
+ *
+ * @note
+ * The signal mask can only be saved by the #EXCEPTIONS4C_BACKEND_SIGSETJMP
+ * and #EXCEPTIONS4C_BACKEND_UCONTEXT backends. Otherwise, a
+ * #TRY_SIGNALSAFE block behaves exactly like a #TRY block.
+ *
+ * @see TRY
+ */
+#define TRY_SIGNALSAFE                                                      \
+                                                                            \
+  EXCEPTIONS4C_START_BLOCK(false, true)                                     \
+  if (e4c_try(EXCEPTIONS4C_DEBUG))
+
+/**
+ * Introduces a block of code that may throw exceptions, and that MUST
+ * finish before a deadline.
+ *
+ * @param milliseconds the time the block is allowed to run.
+ *
+ * A #TRY_WITHIN block works exactly like a #TRY block, except that a
+ * #DEADLINE_EXCEEDED exception is thrown if the block does not finish in
+ * time. This caps the latency of CPU-bound work, such as searching or
+ * number crunching, without having to check for cancellation inside the
+ * code that does the work.
+ *
+ * ```c
+ * TRY_WITHIN (50) {
+ *     solved = solve_sudoku(grid);
+ * } CATCH (DEADLINE_EXCEEDED) {
+ *     solved = false;
+ * }
+ * ```
+ *
+ * Deadlines can be nested: an inner deadline cannot extend the outer one.
+ * The deadline only covers the #TRY part of the block; it stops when the
+ * block is exited or an exception is thrown. After a #RETRY, the block is
+ * given the same time again. An outer deadline that expires while an inner
+ * block is catching or finalizing is thrown when the inner block is done,
+ * so it cannot be caught by the inner block.
+ *
+ * Each thread has its own POSIX timer, created the first time a
+ * #TRY_WITHIN block is entered, which delivers a real-time signal to that
+ * very thread when the innermost deadline expires. Entering a block only
+ * rearms the timer when its deadline is earlier than the outer one.
+ *
+ * @note
+ * The exception is thrown from a signal handler, so the code inside the
+ * block MUST be safe to interrupt at any point. Code that acquires locks
+ * or allocates memory, even indirectly through library functions such as
+ * <tt>regexec</tt> or <tt>printf</tt>, MUST be enclosed between
+ * #e4c_defer_deadlines and #e4c_resume_deadlines:
+ *
+ * ```c
+ * TRY_WITHIN (50) {
+ *     while (!solve_step(grid)) {
+ *         e4c_defer_deadlines();
+ *         printf("Still solving...\n");
+ *         e4c_resume_deadlines();
+ *     }
+ * } CATCH (DEADLINE_EXCEEDED) {
+ *     solved = false;
+ * }
+ * ```
+ *
+ * Deadlines that expire while they are deferred, or while exceptions4c
+ * itself is allocating memory, are delivered right after. Deadlines are
+ * only enforced in Linux; in other platforms, a #TRY_WITHIN block behaves
+ * exactly like a #TRY block.
+ *
+ * @see DEADLINE_EXCEEDED
+ * @see e4c_defer_deadlines
+ * @see TRY
+ */
+#define TRY_WITHIN(milliseconds)                                            \
+                                                                            \
+  EXCEPTIONS4C_START_BLOCK(false, false)                                    \
+  if (e4c_try_within((milliseconds), EXCEPTIONS4C_DEBUG))
+
 /**
  * Introduces a block of code that handles exceptions thrown by a
  * preceding #TRY block.
@@ -106,6 +208,39 @@ extern "C" {
                                                                             \
   else if (e4c_catch(&exception_type, EXCEPTIONS4C_DEBUG))
 
+/**
+ * Introduces a block of code that handles exceptions of several types
+ * thrown by a preceding #TRY block.
+ *
+ * @param ... the types of exception to catch (up to 16).
+ *
+ * A #CATCH_ANY block works like a sequence of #CATCH blocks with
+ * identical bodies, but the thrown exception is matched against all the
+ * supplied types in one pass.
+ *
+ * ```c
+ * TRY {
+ *   config = read_config(file_path);
+ * } CATCH_ANY (FILE_NOT_FOUND, PERMISSION_DENIED, PARSE_ERROR) {
+ *   config = default_config();
+ * }
+ * ```
+ *
+ * @see TRY
+ * @see CATCH
+ */
+#define CATCH_ANY(...)                                                      \
+                                                                            \
+  else if (                                                                 \
+    e4c_catch_any(                                                          \
+      (const struct e4c_exception_type * const []) {                        \
+        EXCEPTIONS4C_ADDRESSES(__VA_ARGS__)                                 \
+      },                                                                    \
+      EXCEPTIONS4C_COUNT(__VA_ARGS__),                                      \
+      EXCEPTIONS4C_DEBUG                                                    \
+    )                                                                       \
+  )
+
 /**
  * Introduces a block of code that handles any exception thrown by a
  * preceding #TRY block, regardless of its type.
@@ -131,6 +266,88 @@ extern "C" {
                                                                             \
   else if (e4c_catch(NULL, EXCEPTIONS4C_DEBUG))
 
+/**
+ * Introduces a block of code that handles exceptions of a
+ * [family](#DECLARE_EXCEPTION_TYPES) through a <tt>switch</tt> statement.
+ *
+ * @param family the name of the exception family.
+ *
+ * A #CATCH_SWITCH block handles any exception whose type (or any of its
+ * supertypes) belongs to the supplied family. The body of the block
+ * MUST consist of #CATCH_CASE labels and, optionally, one
+ * #CATCH_DEFAULT label.
+ *
+ * The identifier of the thrown exception type is computed once, and
+ * then control jumps directly to the matching #CATCH_CASE label. If
+ * there is no label for that type, control jumps to the label of its
+ * closest supertype, and so on. If no label matches any of them,
+ * control jumps to the #CATCH_DEFAULT label (if any).
+ *
+ * ```c
+ * TRY {
+ *   parse_frame(buffer);
+ * } CATCH_SWITCH (PROTOCOL_ERRORS) {
+ *   CATCH_CASE (BAD_CHECKSUM)
+ *     status = 400;
+ *     break;
+ *   CATCH_CASE (BAD_FRAME)
+ *     status = 422;
+ *     break;
+ *   CATCH_DEFAULT
+ *     status = 500;
+ * }
+ * ```
+ *
+ * @note
+ * Every exception of the family is considered handled by a #CATCH_SWITCH
+ * block, even if no label matches its type.
+ *
+ * @see CATCH_CASE
+ * @see CATCH_DEFAULT
+ * @see DECLARE_EXCEPTION_TYPES
+ */
+#define CATCH_SWITCH(family)                                                \
+                                                                            \
+  else if (e4c_catch_family(&family ## _FAMILY, EXCEPTIONS4C_DEBUG))        \
+    for (                                                                   \
+      const int * exceptions4c_parents = family ## _FAMILY.parents;         \
+      exceptions4c_parents != NULL;                                         \
+      exceptions4c_parents = NULL                                           \
+    )                                                                       \
+      for (                                                                 \
+        int exceptions4c_id = e4c_get_exception_id(&family ## _FAMILY);     \
+        exceptions4c_id != 0;                                               \
+        exceptions4c_id = exceptions4c_parents[exceptions4c_id]             \
+      )                                                                     \
+        switch (exceptions4c_id)
+
+/**
+ * Introduces a label of a #CATCH_SWITCH block that handles exceptions of
+ * the supplied type and its subtypes.
+ *
+ * @param type the type of exception to handle.
+ *
+ * @see CATCH_SWITCH
+ */
+#define CATCH_CASE(type)                                                    \
+                                                                            \
+  case type ## _ID:                                                         \
+    exceptions4c_id = 0;
+
+/**
+ * Introduces a label of a #CATCH_SWITCH block that handles exceptions
+ * not matched by any #CATCH_CASE label.
+ *
+ * @see CATCH_SWITCH
+ */
+#define CATCH_DEFAULT                                                       \
+                                                                            \
+  default:                                                                  \
+    if (exceptions4c_parents[exceptions4c_id] != 0) {                       \
+      break;                                                                \
+    }                                                                       \
+    exceptions4c_id = 0;
+
 /**
  * Introduces a block of code that is executed after a #TRY block,
  * regardless of whether an exception was thrown or not.
@@ -184,6 +401,229 @@ extern "C" {
     )                                                                       \
   )
 
+/**
+ * Throws an exception previously captured via #e4c_capture.
+ *
+ * @param exception the captured exception to throw.
+ *
+ * This macro propagates the captured exception, along with its causes, as
+ * if it was thrown in the current thread. It is not formatted again: its
+ * type, message, and debug information are preserved. The library takes
+ * ownership of the captured exception, so it MUST NOT be used afterwards.
+ *
+ * @note
+ * Captured exceptions can be transferred between threads. For example, a
+ * worker thread can capture an exception and a joining thread can throw it
+ * again, so that it is handled by the code that submitted the work.
+ *
+ * @see e4c_capture
+ */
+#define THROW_CAPTURED(exception)                                           \
+                                                                            \
+  EXCEPTIONS4C_LONG_JUMP(                                                   \
+    e4c_rethrow_captured(                                                   \
+      (exception),                                                          \
+      EXCEPTIONS4C_DEBUG                                                    \
+    )                                                                       \
+  )
+
+/**
+ * Throws an exception from a signal handler.
+ *
+ * @param exception_type the type of the exception to throw.
+ * @param message the error message, or <tt>NULL</tt> to use the default
+ *   message of the exception type.
+ *
+ * Unlike #THROW, which allocates and formats a new exception, this macro
+ * takes a preallocated exception and copies the message as is, so that it
+ * only performs async-signal-safe operations before jumping to the nearest
+ * #TRY_SIGNALSAFE block. Calling #THROW from a signal handler that
+ * interrupted <tt>malloc</tt> may deadlock; #THROW_FROM_SIGNAL will not.
+ *
+ * ```c
+ * void segfault(int _) {
+ *     THROW_FROM_SIGNAL(SEGFAULT, "Segmentation fault");
+ * }
+ * ```
+ *
+ * The [initializer](#e4c_context.initialize_exception) of the exception
+ * context is not called for these exceptions. If the current exception
+ * block was going to suppress an exception, it cannot be deleted inside a
+ * signal handler, so it is deleted along with the new one instead.
+ *
+ * @note
+ * Each thread can hold up to <tt>EXCEPTIONS4C_SIGNAL_SLOTS</tt> (4 by
+ * default) exceptions thrown from signal handlers at the same time; the
+ * program is abruptly terminated if they run out.
+ * The exception context MUST have been used by the current thread before
+ * the signal is received, for example, by entering a #TRY_SIGNALSAFE block;
+ * otherwise, the program is abruptly terminated, since creating the context
+ * of a thread is not async-signal-safe.
+ *
+ * @see TRY_SIGNALSAFE
+ */
+#define THROW_FROM_SIGNAL(exception_type, message)                          \
+                                                                            \
+  EXCEPTIONS4C_LONG_JUMP(                                                   \
+    e4c_throw_from_signal(                                                  \
+      &exception_type,                                                      \
+      #exception_type,                                                      \
+      EXCEPTIONS4C_DEBUG,                                                   \
+      (message)                                                             \
+    )                                                                       \
+  )
+
+/**
+ * Maps a signal to an exception type.
+ *
+ * @param signal_number the number of the signal to map.
+ * @param exception_type the type of the exceptions the signal will be
+ *   turned into.
+ *
+ * This macro creates an #e4c_signal_mapping, so that a table of mappings
+ * can be passed to #e4c_map_signals.
+ *
+ * ```c
+ * static const struct e4c_signal_mapping mappings[] = {
+ *     SIGNAL_MAPPING(SIGSEGV, SEGMENTATION_FAULT),
+ *     SIGNAL_MAPPING(SIGUSR1, INTERRUPTED)
+ * };
+ * ```
+ *
+ * @see e4c_map_signals
+ */
+#define SIGNAL_MAPPING(signal_number, exception_type)                       \
+                                                                            \
+  {(signal_number), &exception_type, #exception_type}
+
+/**
+ * Introduces a block of code that accesses memory-mapped files.
+ *
+ * @param address the start of the memory region to probe.
+ * @param size the size of the memory region, in bytes.
+ *
+ * When a file is truncated while it is mapped into memory, accessing the
+ * pages past its new end raises <tt>SIGBUS</tt>, which kills the program.
+ * If a <tt>SIGBUS</tt> or <tt>SIGSEGV</tt> at an address within the
+ * probed region is raised inside a #PROBE block, a #MAPPED_IO_ERROR is
+ * thrown instead, right after the block.
+ *
+ * ```c
+ * TRY {
+ *     PROBE (mapping, size) {
+ *         for (size_t index = 0; index < size; index++) {
+ *             checksum += mapping[index];
+ *         }
+ *     }
+ * } CATCH (MAPPED_IO_ERROR) {
+ *     const struct e4c_signal_info * info = e4c_get_signal_info(e4c_get_exception());
+ *     printf("File truncated at offset %zu\n", info->offset);
+ * }
+ * ```
+ *
+ * Unlike a #TRY block, a #PROBE block does not allocate memory, so a
+ * single one can cover any number of page accesses. Entering and exiting
+ * the block only saves the current execution context and stores a
+ * pointer in thread-local memory.
+ *
+ * @note
+ * A #PROBE block MUST NOT be exited via <tt>goto</tt>, <tt>break</tt>,
+ * <tt>continue</tt>, or <tt>return</tt>. Exception blocks started inside
+ * it are discarded when a fault is detected, without executing their
+ * #FINALLY blocks.
+ *
+ * @see MAPPED_IO_ERROR
+ */
+#define PROBE(address, size)                                                \
+                                                                            \
+  EXCEPTIONS4C_PROBE(                                                       \
+    address,                                                                \
+    size,                                                                   \
+    EXCEPTIONS4C_PROBE_NAME(__LINE__)                                       \
+  )
+
+/** @internal Starts a #PROBE block whose state is stored in a variable with the supplied name. */
+#define EXCEPTIONS4C_PROBE(address, size, probe)                            \
+                                                                            \
+  for (                                                                     \
+    struct e4c_probe probe = {._base = (address), ._size = (size)};         \
+    probe._stage == 0;                                                      \
+  )                                                                         \
+    for (                                                                   \
+      EXCEPTIONS4C_SET_JUMP(&probe._env, false);                            \
+      e4c_probe_next(&probe, EXCEPTIONS4C_DEBUG);                           \
+    )
+
+/** @internal Names the variable of a #PROBE block after its line, so that nested blocks do not shadow each other. */
+#define EXCEPTIONS4C_PROBE_NAME(line) EXCEPTIONS4C_PROBE_PASTE(line)
+
+/** @internal Pastes the line of a #PROBE block, once expanded, to the name of its variable. */
+#define EXCEPTIONS4C_PROBE_PASTE(line) exceptions4c_probe_ ## line
+
+/**
+ * Throws the exception an asynchronous operation failed with, if any.
+ *
+ * @param operation a pointer to the operation to check.
+ *
+ * This macro SHOULD be used in the continuation of an asynchronous
+ * operation, inside its own #TRY block. If the operation failed (see
+ * #e4c_operation_fail), the captured exception is thrown again, as if it
+ * was thrown by the continuation itself; otherwise, nothing happens.
+ *
+ * ```c
+ * static void on_read_completed(struct request * request) {
+ *     TRY {
+ *         THROW_IF_FAILED(&request->operation);
+ *         send_response(request);
+ *     } CATCH (IO_ERROR) {
+ *         close_connection(request);
+ *     }
+ * }
+ * ```
+ *
+ * @see e4c_operation
+ * @see e4c_operation_fail
+ */
+#define THROW_IF_FAILED(operation)                                          \
+                                                                            \
+  if ((operation)->_failure != NULL)                                        \
+    THROW_CAPTURED(e4c_operation_take(operation));                          \
+  else (void) 0
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+
+/**
+ * Throws #CANCELLED if the current exception context has been cancelled.
+ *
+ * Long-running loops SHOULD use this macro periodically, so that work
+ * that is no longer needed stops as soon as possible. If the
+ * [cancellation token](#e4c_cancellation_token) of the current exception
+ * context has been cancelled (see #e4c_cancel), a #CANCELLED exception is
+ * thrown, carrying the reason as its message; otherwise, nothing happens.
+ *
+ * ```c
+ * for (int index = 0; index < shard->count; index++) {
+ *     CHECKPOINT();
+ *     score(query, &shard->documents[index]);
+ * }
+ * ```
+ *
+ * Once the current exception context is retrieved, a checkpoint that is
+ * not cancelled only takes a single relaxed atomic load, inline, so it is
+ * cheap enough to be used in hot loops.
+ *
+ * @see e4c_cancellation_token
+ * @see CANCELLED
+ */
+#define CHECKPOINT()                                                        \
+                                                                            \
+  if (!e4c_may_be_cancelled(e4c_get_context())) (void) 0; else              \
+  e4c_checkpoint(EXCEPTIONS4C_DEBUG)
+
+#endif
+
+#ifndef EXCEPTIONS4C_NO_RETRY
+
 /**
  * Repeats the previous #TRY or #USE block entirely
  *
@@ -254,6 +694,63 @@ extern "C" {
     )                                                                       \
   )
 
+/**
+ * Repeats the previous #TRY or #USE block entirely, after waiting
+ * according to a backoff policy.
+ *
+ * @param max_attempts the maximum number of attempts to retry.
+ * @param policy the [backoff policy](#e4c_backoff) to wait according to.
+ * @param type the type of exception to throw.
+ * @param format the error message.
+ * @param ... an optional list of arguments that will be formatted according to <tt>format</tt>.
+ *
+ * This macro works like #RETRY, except that it waits before repeating the
+ * block, so that many clients failing at once do not retry in lockstep
+ * against an overloaded dependency. The delay grows with the number of
+ * attempts, as specified by the policy. If the time budget of the policy
+ * would be exceeded by waiting, the supplied exception is thrown right
+ * away, as if the maximum number of attempts was reached.
+ *
+ * ```c
+ * static const struct e4c_backoff policy = {
+ *   .strategy = E4C_BACKOFF_DECORRELATED_JITTER,
+ *   .initial_delay = 10,
+ *   .max_delay = 1000,
+ *   .budget = 5000
+ * };
+ *
+ * TRY {
+ *   response = send_request(request);
+ * } CATCH (OVERLOADED) {
+ *   RETRY_BACKOFF(5, policy, OVERLOADED, "Service still overloaded");
+ * }
+ * ```
+ *
+ * @pre
+ *   - A #RETRY_BACKOFF statement MUST be placed in #CATCH or #FINALLY blocks only.
+ * @post
+ *   - Control does not return to the #RETRY_BACKOFF point.
+ *
+ * @see RETRY
+ * @see e4c_backoff
+ */
+#define RETRY_BACKOFF(max_attempts, policy, type, format, ...)              \
+                                                                            \
+  EXCEPTIONS4C_LONG_JUMP(                                                   \
+    e4c_restart_backoff(                                                    \
+      false,                                                                \
+      max_attempts,                                                         \
+      &(policy),                                                            \
+      &type,                                                                \
+      #type,                                                                \
+      EXCEPTIONS4C_DEBUG,                                                   \
+      (format)                                                              \
+      __VA_OPT__(,) __VA_ARGS__                                             \
+    )                                                                       \
+  )
+
+#endif
+
 /**
  * Introduces a block of code with automatic acquisition and disposal of a
  * resource
@@ -324,8 +821,8 @@ extern "C" {
  * Here is the typical usage of #WITH... #USE:
  *
  * ```c
- * const struct e4c_exception_type file_error = {NULL, "File error"};
- * const struct e4c_exception_type config_error = {NULL, "Config error"};
+ * const struct e4c_exception_type file_error = {.supertype = NULL, .default_message = "File error"};
+ * const struct e4c_exception_type config_error = {.supertype = NULL, .default_message = "Config error"};
  * FILE * file;
  * char title[256] = "";
  * WITH(file, CLOSE_FILE) {
@@ -357,7 +854,7 @@ extern "C" {
  */
 #define WITH(disposal)                                                      \
                                                                             \
-  EXCEPTIONS4C_START_BLOCK(true)                                            \
+  EXCEPTIONS4C_START_BLOCK(true, false)                                     \
   if (e4c_dispose(EXCEPTIONS4C_DEBUG)) {                                    \
     (void) (disposal);                                                      \
   } else if (e4c_acquire(EXCEPTIONS4C_DEBUG)) {
@@ -389,6 +886,8 @@ extern "C" {
                                                                             \
   } else if (e4c_try(EXCEPTIONS4C_DEBUG) && (test))
 
+#ifndef EXCEPTIONS4C_NO_RETRY
+
 /**
  * Repeats the previous #WITH block entirely
  *
@@ -464,63 +963,375 @@ extern "C" {
     )                                                                       \
   )
 
+/**
+ * Repeats the previous #WITH block entirely, after waiting according to a
+ * backoff policy.
+ *
+ * @param max_attempts the maximum number of attempts to reacquire.
+ * @param policy the [backoff policy](#e4c_backoff) to wait according to.
+ * @param type the type of exception throw when <tt>max_attempts</tt> is exceeded.
+ * @param format The error message.
+ * @param ... an optional list of arguments that will be formatted according to <tt>format</tt>.
+ *
+ * This macro works like #REACQUIRE, except that it waits before acquiring
+ * the resource again, the same way #RETRY_BACKOFF does.
+ *
+ * @see REACQUIRE
+ * @see RETRY_BACKOFF
+ * @see e4c_backoff
+ */
+#define REACQUIRE_BACKOFF(max_attempts, policy, type, format, ...)          \
+                                                                            \
+  EXCEPTIONS4C_LONG_JUMP(                                                   \
+    e4c_restart_backoff(                                                    \
+      true,                                                                 \
+      max_attempts,                                                         \
+      &(policy),                                                            \
+      &type,                                                                \
+      #type,                                                                \
+      EXCEPTIONS4C_DEBUG,                                                   \
+      (format)                                                              \
+      __VA_OPT__(,) __VA_ARGS__                                             \
+    )                                                                       \
+  )
+
+#endif
+
 /**
  * @internal Starts a new exception block.
  *
  * @param should_acquire if <tt>true</tt>, the exception block will start #ACQUIRING a resource.
+ * @param save_signal_mask if <tt>true</tt>, the signal mask will be restored when an exception is caught.
  */
-#define EXCEPTIONS4C_START_BLOCK(should_acquire)                            \
+#define EXCEPTIONS4C_START_BLOCK(should_acquire, save_signal_mask)          \
                                                                             \
   for (                                                                     \
-    EXCEPTIONS4C_SET_JUMP(e4c_start(should_acquire, EXCEPTIONS4C_DEBUG));   \
+    EXCEPTIONS4C_SET_JUMP(                                                  \
+      e4c_start(should_acquire, EXCEPTIONS4C_DEBUG),                        \
+      save_signal_mask                                                      \
+    );                                                                      \
     e4c_next(EXCEPTIONS4C_DEBUG) || (                                       \
       e4c_is_uncaught() && (EXCEPTIONS4C_LONG_JUMP(e4c_get_env()), true)    \
     );                                                                      \
   )
 
-#ifndef HAVE_SIGSETJMP
-
 /**
- * @internal Saves the current execution context.
+ * Selects <tt>setjmp</tt> and <tt>longjmp</tt> as the non-local jump backend.
  *
- * @param env the variable to store the current [execution context](#e4c_env).
+ * @see EXCEPTIONS4C_BACKEND
  */
-#define EXCEPTIONS4C_SET_JUMP(env) setjmp(*(env))
+#define EXCEPTIONS4C_BACKEND_SETJMP 1
 
 /**
- * @internal Loads the supplied execution context.
+ * Selects <tt>sigsetjmp</tt> and <tt>siglongjmp</tt> as the non-local jump backend.
  *
- * @param env the [execution context](#e4c_env) to load.
+ * This backend is required to restore the signal mask in #TRY_SIGNALSAFE blocks.
+ *
+ * @see EXCEPTIONS4C_BACKEND
  */
-#define EXCEPTIONS4C_LONG_JUMP(env) longjmp(*(env), 1)
-
-/** @internal Stores information to restore a calling environment. */
-typedef jmp_buf e4c_env;
-
-#else
+#define EXCEPTIONS4C_BACKEND_SIGSETJMP 2
 
 /**
- * @internal Saves the current execution context.
+ * Selects <tt>__builtin_setjmp</tt> and <tt>__builtin_longjmp</tt> as the non-local jump backend.
  *
- * @param env the variable to store the current [execution context](#e4c_env).
+ * These GCC and Clang builtins save far fewer registers than <tt>setjmp</tt>, so they are much cheaper. They do not
+ * save the signal mask.
+ *
+ * @see EXCEPTIONS4C_BACKEND
  */
-#define EXCEPTIONS4C_SET_JUMP(env) sigsetjmp(*(env), 1)
+#define EXCEPTIONS4C_BACKEND_BUILTIN 3
 
 /**
- * @internal Loads the supplied execution context.
+ * Selects <tt>getcontext</tt> and <tt>setcontext</tt> as the non-local jump backend.
  *
- * @param env the [execution context](#e4c_env) to load.
+ * This backend always saves and restores the signal mask, even in regular #TRY blocks.
+ *
+ * @see EXCEPTIONS4C_BACKEND
  */
-#define EXCEPTIONS4C_LONG_JUMP(env) siglongjmp(*(env), 1)
+#define EXCEPTIONS4C_BACKEND_UCONTEXT 4
 
-/** @internal Stores information to restore a calling environment. */
-typedef sigjmp_buf e4c_env;
+/**
+ * Selects a user-defined non-local jump backend.
+ *
+ * When this backend is selected, these macros MUST be defined before including the header file:
+ *
+ * - <tt>EXCEPTIONS4C_ENV</tt>: the type that stores the execution context.
+ * - <tt>EXCEPTIONS4C_SET_JUMP(env, save_signal_mask)</tt>: saves the execution context into <tt>*env</tt>.
+ * - <tt>EXCEPTIONS4C_LONG_JUMP(env)</tt>: loads the execution context from <tt>*env</tt>.
+ *
+ * @see EXCEPTIONS4C_BACKEND
+ */
+#define EXCEPTIONS4C_BACKEND_CUSTOM 5
 
+#if !defined(EXCEPTIONS4C_BACKEND) && defined(HAVE_SIGSETJMP)
+#define EXCEPTIONS4C_BACKEND EXCEPTIONS4C_BACKEND_SIGSETJMP
 #endif
 
-#ifndef NDEBUG
-
-/** @internal Captures debug information about the running program. */
+#ifndef EXCEPTIONS4C_BACKEND
+/**
+ * Selects the non-local jump backend.
+ *
+ * Define this macro at compiler level to choose how exception blocks save and load their execution contexts:
+ *
+ * - #EXCEPTIONS4C_BACKEND_SETJMP (default, unless <tt>HAVE_SIGSETJMP</tt> is defined)
+ * - #EXCEPTIONS4C_BACKEND_SIGSETJMP (default, if <tt>HAVE_SIGSETJMP</tt> is defined)
+ * - #EXCEPTIONS4C_BACKEND_BUILTIN
+ * - #EXCEPTIONS4C_BACKEND_UCONTEXT
+ * - #EXCEPTIONS4C_BACKEND_CUSTOM
+ *
+ * ```sh
+ * cc -DEXCEPTIONS4C_BACKEND=EXCEPTIONS4C_BACKEND_BUILTIN ...
+ * ```
+ *
+ * @warning
+ * The library and the programs using it MUST be compiled with the same backend
+ * and the same feature profile; otherwise, programs fail to link.
+ */
+#define EXCEPTIONS4C_BACKEND EXCEPTIONS4C_BACKEND_SETJMP
+#endif
+
+#if EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_SETJMP
+
+/**
+ * @internal Saves the current execution context.
+ *
+ * @param env the variable to store the current [execution context](#e4c_env).
+ * @param save_signal_mask ignored, since <tt>setjmp</tt> does not save the signal mask.
+ */
+#define EXCEPTIONS4C_SET_JUMP(env, save_signal_mask) setjmp(*(env))
+
+/**
+ * @internal Loads the supplied execution context.
+ *
+ * @param env the [execution context](#e4c_env) to load.
+ */
+#define EXCEPTIONS4C_LONG_JUMP(env) longjmp(*(env), 1)
+
+/** @internal Stores information to restore a calling environment. */
+typedef jmp_buf e4c_env;
+
+#elif EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_SIGSETJMP
+
+/**
+ * @internal Saves the current execution context.
+ *
+ * @param env the variable to store the current [execution context](#e4c_env).
+ * @param save_signal_mask if <tt>true</tt>, the current signal mask will be saved too.
+ */
+#define EXCEPTIONS4C_SET_JUMP(env, save_signal_mask) sigsetjmp(*(env), (save_signal_mask))
+
+/**
+ * @internal Loads the supplied execution context.
+ *
+ * @param env the [execution context](#e4c_env) to load.
+ */
+#define EXCEPTIONS4C_LONG_JUMP(env) siglongjmp(*(env), 1)
+
+/** @internal Stores information to restore a calling environment. */
+typedef sigjmp_buf e4c_env;
+
+#elif EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_BUILTIN
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#error "EXCEPTIONS4C_BACKEND_BUILTIN requires GCC or Clang."
+#endif
+
+/**
+ * @internal Saves the current execution context.
+ *
+ * @param env the variable to store the current [execution context](#e4c_env).
+ * @param save_signal_mask ignored, since <tt>__builtin_setjmp</tt> does not save the signal mask.
+ */
+#define EXCEPTIONS4C_SET_JUMP(env, save_signal_mask) __builtin_setjmp(*(env))
+
+/**
+ * @internal Loads the supplied execution context.
+ *
+ * @param env the [execution context](#e4c_env) to load.
+ *
+ * @note
+ * <tt>__builtin_longjmp</tt> may not be called from the same function that calls <tt>__builtin_setjmp</tt>, so it
+ * is called from #e4c_long_jump instead.
+ */
+#define EXCEPTIONS4C_LONG_JUMP(env) e4c_long_jump(env)
+
+/** @internal Stores information to restore a calling environment. */
+typedef void * e4c_env[5];
+
+#elif EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_UCONTEXT
+
+#include <ucontext.h>
+
+/**
+ * @internal Saves the current execution context.
+ *
+ * @param env the variable to store the current [execution context](#e4c_env).
+ * @param save_signal_mask ignored, since <tt>getcontext</tt> always saves the signal mask.
+ */
+#define EXCEPTIONS4C_SET_JUMP(env, save_signal_mask) getcontext(env)
+
+/**
+ * @internal Loads the supplied execution context.
+ *
+ * @param env the [execution context](#e4c_env) to load.
+ *
+ * @note
+ * <tt>setcontext</tt> only returns if it fails, in which case the program is aborted.
+ */
+#define EXCEPTIONS4C_LONG_JUMP(env) ((void) setcontext(env), abort())
+
+/** @internal Stores information to restore a calling environment. */
+typedef ucontext_t e4c_env;
+
+#elif EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_CUSTOM
+
+#if !defined(EXCEPTIONS4C_ENV) || !defined(EXCEPTIONS4C_SET_JUMP) || !defined(EXCEPTIONS4C_LONG_JUMP)
+#error "EXCEPTIONS4C_BACKEND_CUSTOM requires EXCEPTIONS4C_ENV, EXCEPTIONS4C_SET_JUMP, and EXCEPTIONS4C_LONG_JUMP."
+#endif
+
+/** @internal Stores information to restore a calling environment. */
+typedef EXCEPTIONS4C_ENV e4c_env;
+
+#else
+#error "Unknown EXCEPTIONS4C_BACKEND."
+#endif
+
+#if EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_SETJMP
+/** @internal The part of the ABI symbol that identifies the backend. */
+#define EXCEPTIONS4C_ABI_BACKEND setjmp
+#elif EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_SIGSETJMP
+#define EXCEPTIONS4C_ABI_BACKEND sigsetjmp
+#elif EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_BUILTIN
+#define EXCEPTIONS4C_ABI_BACKEND builtin
+#elif EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_UCONTEXT
+#define EXCEPTIONS4C_ABI_BACKEND ucontext
+#else
+#define EXCEPTIONS4C_ABI_BACKEND custom
+#endif
+
+#ifndef EXCEPTIONS4C_NO_RETRY
+/** @internal The part of the ABI symbol that identifies whether retries are supported. */
+#define EXCEPTIONS4C_ABI_RETRY retry
+#else
+#define EXCEPTIONS4C_ABI_RETRY noretry
+#endif
+
+#ifndef EXCEPTIONS4C_NO_ERRNO
+/** @internal The part of the ABI symbol that identifies whether <tt>errno</tt> is captured. */
+#define EXCEPTIONS4C_ABI_ERRNO errnumber
+#else
+#define EXCEPTIONS4C_ABI_ERRNO noerrnumber
+#endif
+
+#ifndef EXCEPTIONS4C_NO_DEBUG_INFO
+/** @internal The part of the ABI symbol that identifies whether debug info is captured. */
+#define EXCEPTIONS4C_ABI_DEBUG_INFO debuginfo
+#else
+#define EXCEPTIONS4C_ABI_DEBUG_INFO nodebuginfo
+#endif
+
+#ifndef EXCEPTIONS4C_NO_HOOKS
+/** @internal The part of the ABI symbol that identifies whether hooks are supported. */
+#define EXCEPTIONS4C_ABI_HOOKS hooks
+#else
+#define EXCEPTIONS4C_ABI_HOOKS nohooks
+#endif
+
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+/** @internal The part of the ABI symbol that identifies whether the context registry is supported. */
+#define EXCEPTIONS4C_ABI_REGISTRY registry
+#else
+#define EXCEPTIONS4C_ABI_REGISTRY noregistry
+#endif
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+/** @internal The part of the ABI symbol that identifies whether cancellation tokens are supported. */
+#define EXCEPTIONS4C_ABI_CANCELLATION cancellation
+#else
+#define EXCEPTIONS4C_ABI_CANCELLATION nocancellation
+#endif
+
+/** @internal Pastes the parts of the ABI symbol together. */
+#define EXCEPTIONS4C_ABI_PASTE(backend, retry, error_number, debug_info, hooks, registry, cancellation) \
+                                                                            \
+  e4c_abi_ ## backend ## _ ## retry ## _ ## error_number ## _ ## debug_info ## _ ## hooks ## _ ## registry ## _ ## cancellation
+
+/** @internal Expands the parts of the ABI symbol before pasting them together. */
+#define EXCEPTIONS4C_ABI_EXPAND(...) EXCEPTIONS4C_ABI_PASTE(__VA_ARGS__)
+
+/**
+ * @internal The name of the symbol that identifies the backend and the feature profile.
+ *
+ * The library defines this symbol, and every translation unit that
+ * includes this header references it. So, if the library and a program
+ * are compiled with a different backend or feature profile, the layout of
+ * the data structures they share would differ; instead, the program fails
+ * to link.
+ */
+#define EXCEPTIONS4C_ABI                                                    \
+                                                                            \
+  EXCEPTIONS4C_ABI_EXPAND(                                                  \
+    EXCEPTIONS4C_ABI_BACKEND,                                               \
+    EXCEPTIONS4C_ABI_RETRY,                                                 \
+    EXCEPTIONS4C_ABI_ERRNO,                                                 \
+    EXCEPTIONS4C_ABI_DEBUG_INFO,                                            \
+    EXCEPTIONS4C_ABI_HOOKS,                                                 \
+    EXCEPTIONS4C_ABI_REGISTRY,                                              \
+    EXCEPTIONS4C_ABI_CANCELLATION                                           \
+  )
+
+/**
+ * @internal Counts the supplied arguments (up to 16).
+ *
+ * This limits #CATCH_ANY to 16 exception types: with more arguments, the
+ * count is one of the arguments themselves, and the expansion fails to
+ * compile.
+ */
+#define EXCEPTIONS4C_COUNT(...)                                             \
+                                                                            \
+  EXCEPTIONS4C_COUNT_ARGUMENTS(                                             \
+    __VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0   \
+  )
+
+/** @internal Selects the seventeenth argument. */
+#define EXCEPTIONS4C_COUNT_ARGUMENTS(                                       \
+  _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,    \
+  count, ...) count
+
+/** @internal Concatenates two tokens, after expanding them. */
+#define EXCEPTIONS4C_CONCAT(prefix, suffix) EXCEPTIONS4C_CONCAT_TOKENS(prefix, suffix)
+
+/** @internal Concatenates two tokens. */
+#define EXCEPTIONS4C_CONCAT_TOKENS(prefix, suffix) prefix ## suffix
+
+/** @internal Takes the address of each supplied argument (up to 16). */
+#define EXCEPTIONS4C_ADDRESSES(...)                                         \
+                                                                            \
+  EXCEPTIONS4C_CONCAT(                                                      \
+    EXCEPTIONS4C_ADDRESSES_,                                                \
+    EXCEPTIONS4C_COUNT(__VA_ARGS__)                                         \
+  )(__VA_ARGS__)
+
+#define EXCEPTIONS4C_ADDRESSES_1(first) &first
+#define EXCEPTIONS4C_ADDRESSES_2(first, ...) &first, EXCEPTIONS4C_ADDRESSES_1(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_3(first, ...) &first, EXCEPTIONS4C_ADDRESSES_2(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_4(first, ...) &first, EXCEPTIONS4C_ADDRESSES_3(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_5(first, ...) &first, EXCEPTIONS4C_ADDRESSES_4(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_6(first, ...) &first, EXCEPTIONS4C_ADDRESSES_5(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_7(first, ...) &first, EXCEPTIONS4C_ADDRESSES_6(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_8(first, ...) &first, EXCEPTIONS4C_ADDRESSES_7(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_9(first, ...) &first, EXCEPTIONS4C_ADDRESSES_8(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_10(first, ...) &first, EXCEPTIONS4C_ADDRESSES_9(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_11(first, ...) &first, EXCEPTIONS4C_ADDRESSES_10(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_12(first, ...) &first, EXCEPTIONS4C_ADDRESSES_11(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_13(first, ...) &first, EXCEPTIONS4C_ADDRESSES_12(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_14(first, ...) &first, EXCEPTIONS4C_ADDRESSES_13(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_15(first, ...) &first, EXCEPTIONS4C_ADDRESSES_14(__VA_ARGS__)
+#define EXCEPTIONS4C_ADDRESSES_16(first, ...) &first, EXCEPTIONS4C_ADDRESSES_15(__VA_ARGS__)
+
+#if !defined(NDEBUG) && !defined(EXCEPTIONS4C_NO_DEBUG_INFO)
+
+/** @internal Captures debug information about the running program. */
 #define EXCEPTIONS4C_DEBUG __FILE__, __LINE__, __func__
 
 #else
@@ -537,14 +1348,17 @@ typedef sigjmp_buf e4c_env;
  * want to #THROW and #CATCH. It serves as a way to group related issues
  * that share common characteristics.
  *
- * Exception types SHOULD be defined as <tt>const</tt>.
+ * Exception types SHOULD be defined as <tt>const</tt>, preferably via
+ * designated initializers, so that fields added in the future do not
+ * need to be initialized explicitly.
  *
  * ```c
- * const e4c_exception_type IO_ERROR = "I/O Error";
+ * const struct e4c_exception_type IO_ERROR = {.supertype = NULL, .default_message = "I/O Error"};
  * ```
  *
  * @see THROW
  * @see CATCH
+ * @see e4c_register_type
  */
 struct e4c_exception_type {
 
@@ -553,6 +1367,171 @@ struct e4c_exception_type {
 
     /** The default message for new exceptions of this type */
     const char * default_message;
+
+    /** A possibly-null pointer to the storage for the precomputed ancestors of this type */
+    struct e4c_type_display * display;
+
+    /** The identifier of this type within its [family](#DECLARE_EXCEPTION_TYPES), or zero */
+    int id;
+};
+
+/**
+ * Represents a family of exception types with dense identifiers.
+ *
+ * Exception families SHOULD be created via #DECLARE_EXCEPTION_TYPES and
+ * #DEFINE_EXCEPTION_TYPES.
+ *
+ * @see CATCH_SWITCH
+ */
+struct e4c_exception_family {
+
+    /** The number of identifiers of this family, including zero. */
+    int count;
+
+    /** The identifier of the supertype of each type of this family, or zero for the root types. */
+    const int * parents;
+
+    /** The type of this family that corresponds to each identifier. */
+    const struct e4c_exception_type * const * types;
+};
+
+/**
+ * Declares a family of exception types with dense identifiers.
+ *
+ * @param family the name of a macro that lists the exception types.
+ *
+ * The family is described by a macro that receives two other macros:
+ *
+ * - <tt>ROOT(name, default_message)</tt> introduces a type without supertype.
+ * - <tt>TYPE(name, supertype, default_message)</tt> introduces a subtype of a previous type of the family.
+ *
+ * ```c
+ * #define PROTOCOL_ERRORS(ROOT, TYPE)                           \
+ *   ROOT(PROTOCOL_ERROR, "Protocol error")                     \
+ *   TYPE(BAD_FRAME,      PROTOCOL_ERROR, "Bad frame")          \
+ *   TYPE(BAD_CHECKSUM,   BAD_FRAME,      "Bad checksum")
+ *
+ * DECLARE_EXCEPTION_TYPES(PROTOCOL_ERRORS);
+ * ```
+ *
+ * This declares each exception type (for example, <tt>BAD_FRAME</tt>),
+ * along with a compile-time constant identifier (<tt>BAD_FRAME_ID</tt>).
+ * The family and its types MUST be defined in one source file through
+ * #DEFINE_EXCEPTION_TYPES.
+ *
+ * @see DEFINE_EXCEPTION_TYPES
+ * @see CATCH_SWITCH
+ */
+#define DECLARE_EXCEPTION_TYPES(family)                                     \
+                                                                            \
+  enum {                                                                    \
+    family ## _NONE,                                                        \
+    family(EXCEPTIONS4C_ROOT_ID, EXCEPTIONS4C_TYPE_ID)                      \
+    family ## _COUNT                                                        \
+  };                                                                        \
+  family(EXCEPTIONS4C_DECLARE_ROOT, EXCEPTIONS4C_DECLARE_TYPE)              \
+  extern const struct e4c_exception_family family ## _FAMILY
+
+/**
+ * Defines a family of exception types with dense identifiers.
+ *
+ * @param family the name of a macro that lists the exception types.
+ *
+ * ```c
+ * DEFINE_EXCEPTION_TYPES(PROTOCOL_ERRORS);
+ * ```
+ *
+ * @pre
+ *   - The family MUST have been declared through #DECLARE_EXCEPTION_TYPES.
+ *
+ * @see DECLARE_EXCEPTION_TYPES
+ */
+#define DEFINE_EXCEPTION_TYPES(family)                                      \
+                                                                            \
+  family(EXCEPTIONS4C_DEFINE_ROOT, EXCEPTIONS4C_DEFINE_TYPE)                \
+  static const int family ## _PARENTS[] = {                                 \
+    0,                                                                      \
+    family(EXCEPTIONS4C_ROOT_PARENT, EXCEPTIONS4C_TYPE_PARENT)              \
+  };                                                                        \
+  static const struct e4c_exception_type * const family ## _TYPES[] = {     \
+    NULL,                                                                   \
+    family(EXCEPTIONS4C_ROOT_ADDRESS, EXCEPTIONS4C_TYPE_ADDRESS)            \
+  };                                                                        \
+  const struct e4c_exception_family family ## _FAMILY = {                   \
+    .count = family ## _COUNT,                                              \
+    .parents = family ## _PARENTS,                                          \
+    .types = family ## _TYPES                                               \
+  };                                                                        \
+  extern const struct e4c_exception_family family ## _FAMILY
+
+/** @internal Declares the identifier of a root type of a family. */
+#define EXCEPTIONS4C_ROOT_ID(name, default_message) name ## _ID,
+
+/** @internal Declares the identifier of a subtype of a family. */
+#define EXCEPTIONS4C_TYPE_ID(name, supertype, default_message) name ## _ID,
+
+/** @internal Declares a root type of a family. */
+#define EXCEPTIONS4C_DECLARE_ROOT(name, default_message)                    \
+  extern const struct e4c_exception_type name;
+
+/** @internal Declares a subtype of a family. */
+#define EXCEPTIONS4C_DECLARE_TYPE(name, supertype, default_message)         \
+  extern const struct e4c_exception_type name;
+
+/** @internal Defines a root type of a family. */
+#define EXCEPTIONS4C_DEFINE_ROOT(name, message)                             \
+  const struct e4c_exception_type name = {                                  \
+    .supertype = NULL,                                                      \
+    .default_message = message,                                             \
+    .id = name ## _ID                                                       \
+  };
+
+/** @internal Defines a subtype of a family. */
+#define EXCEPTIONS4C_DEFINE_TYPE(name, parent, message)                     \
+  const struct e4c_exception_type name = {                                  \
+    .supertype = &parent,                                                   \
+    .default_message = message,                                             \
+    .id = name ## _ID                                                       \
+  };
+
+/** @internal Supplies the parent identifier of a root type of a family. */
+#define EXCEPTIONS4C_ROOT_PARENT(name, default_message) 0,
+
+/** @internal Supplies the parent identifier of a subtype of a family. */
+#define EXCEPTIONS4C_TYPE_PARENT(name, supertype, default_message) supertype ## _ID,
+
+/** @internal Supplies the address of a root type of a family. */
+#define EXCEPTIONS4C_ROOT_ADDRESS(name, default_message) &name,
+
+/** @internal Supplies the address of a subtype of a family. */
+#define EXCEPTIONS4C_TYPE_ADDRESS(name, supertype, default_message) &name,
+
+/**
+ * Stores the precomputed ancestors of an exception type.
+ *
+ * Exception types are usually defined as <tt>const</tt>, so they cannot
+ * be modified when they are [registered](#e4c_register_type). Instead,
+ * they can point to a mutable #e4c_type_display that will be filled by
+ * the library.
+ *
+ * ```c
+ * static struct e4c_type_display io_error_display;
+ * const struct e4c_exception_type IO_ERROR = {.supertype = &ERROR, .default_message = "I/O Error", .display = &io_error_display};
+ * ```
+ *
+ * Once both a thrown exception type and a caught exception type have
+ * been registered, checking if the former extends the latter takes
+ * constant time, regardless of the depth of the type hierarchy.
+ *
+ * @see e4c_register_type
+ */
+struct e4c_type_display {
+
+    /** The number of supertypes of the exception type. */
+    int depth;
+
+    /** The exception type and its supertypes, from the root supertype to the exception type itself; <tt>NULL</tt> until the type is registered. */
+    const struct e4c_exception_type ** ancestors;
 };
 
 /**
@@ -582,91 +1561,982 @@ struct e4c_exception {
     /** A text message describing the specific problem. */
     char message[256];
 
+#ifndef EXCEPTIONS4C_NO_DEBUG_INFO
+
     /** The name of the source file that threw this exception, or <tt>NULL</tt> if <tt>NDEBUG</tt> is defined. */
     const char * file;
 
-    /** The line number in the source file that threw this exception, or zero if <tt>NDEBUG</tt> is defined. */
-    int line;
+    /** The line number in the source file that threw this exception, or zero if <tt>NDEBUG</tt> is defined. */
+    int line;
+
+    /** The name of the function that threw this exception, or <tt>NULL</tt> if <tt>NDEBUG</tt> is defined. */
+    const char * function;
+
+#endif
+
+#ifndef EXCEPTIONS4C_NO_ERRNO
+
+    /** The value of [errno](https://devdocs.io/c/error/errno) at the time this exception was thrown. */
+    int error_number;
+
+#endif
+
+    /** A possibly-null pointer to the current exception when this exception was thrown. */
+    struct e4c_exception * cause;
+
+#ifndef EXCEPTIONS4C_NO_HOOKS
+
+    /** A possibly-null pointer to custom data associated to this exception. */
+    void * data;
+
+#endif
+
+    /**
+     * @internal A possibly-null pointer to the block of memory shared by this exception and its causes.
+     */
+    void * _allocation;
+};
+
+/**
+ * Contains the configuration and the current status of exceptions.
+ *
+ * This structure allows you to configure the way the exception system behaves:
+ *
+ * - Set <strong>uncaught_handler</strong> to a function that will be executed when an exception reaches the top level of the program.
+ * - Set <strong>termination_handler</strong> to a function that will be executed when the program abruptly terminates due to an uncaught exception.
+ * - Set <strong>initialize_exception</strong> to a function that will be executed whenever an exception is thrown. This function MAY create and assign custom data to the exception.
+ * - Set <strong>finalize_exception</strong> to a function that will be executed whenever an exception is deleted. This function MAY delete custom data previously created.
+ *
+ * @see e4c_get_context
+ * @see e4c_set_context_supplier
+ */
+struct e4c_context {
+
+    /**
+     * @internal The current exception block of the running program.
+     */
+    void * _innermost_block;
+
+#ifndef EXCEPTIONS4C_NO_HOOKS
+
+    /** The function to execute in the event of an uncaught exception */
+    void (*uncaught_handler)(const struct e4c_exception * exception);
+
+    /** The function to execute in the event of program termination. */
+    void (*termination_handler)();
+
+    /** The function to execute whenever a new exception is thrown */
+    void (*initialize_exception)(struct e4c_exception * exception);
+
+    /** The function to execute whenever an exception is destroyed */
+    void (*finalize_exception)(const struct e4c_exception * exception);
+
+#endif
+
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+
+    /**
+     * @internal The entry of the context registry, if this context is registered.
+     */
+    void * _registry;
+
+#endif
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+
+    /**
+     * @internal A possibly-null pointer to the cancellation token of this context.
+     */
+    struct e4c_cancellation_token * _cancellation_token;
+
+#endif
+};
+
+/**
+ * Represents the execution stage of an exception block.
+ *
+ * @see e4c_block_snapshot
+ */
+enum e4c_block_stage {
+
+    /** The exception block has started. */
+    E4C_STAGE_BEGINNING,
+
+    /** The exception block is [acquiring a resource](#WITH). */
+    E4C_STAGE_ACQUIRING,
+
+    /** The exception block is [trying something](#TRY) or [using a resource](#USE). */
+    E4C_STAGE_TRYING,
+
+    /** The exception block is [disposing of a resource](#WITH). */
+    E4C_STAGE_DISPOSING,
+
+    /** The exception block is [catching an exception](#CATCH). */
+    E4C_STAGE_CATCHING,
+
+    /** The exception block is [finalizing](#FINALLY). */
+    E4C_STAGE_FINALIZING,
+
+    /** The exception block has finished. */
+    E4C_STAGE_DONE
+};
+
+#ifndef EXCEPTIONS4C_NO_REGISTRY
+
+/**
+ * Contains aggregated statistics of the registered exception contexts.
+ *
+ * @see e4c_get_statistics
+ */
+struct e4c_statistics {
+
+    /** The number of registered contexts. */
+    int contexts;
+
+    /** The total number of exception blocks currently open. */
+    int blocks;
+
+    /** The nesting depth of the innermost exception block currently open in any context. */
+    int max_depth;
+
+    /** The total number of exceptions currently in flight. */
+    int exceptions;
+};
+
+/**
+ * Describes an exception block that is open in a registered context.
+ *
+ * @see e4c_snapshot_context
+ * @see e4c_watchdog_scan
+ */
+struct e4c_block_snapshot {
+
+    /** The stage the exception block is in. */
+    enum e4c_block_stage stage;
+
+    /** The possibly-null name of the source code file that started the exception block. */
+    const char * file;
+
+    /** The number of line that started the exception block, or zero. */
+    int line;
+
+    /** The possibly-null name of the function that started the exception block. */
+    const char * function;
+
+    /** The time elapsed since the exception block started, or since it was first snapshotted if it started before any snapshot was taken, in milliseconds. */
+    long milliseconds;
+};
+
+#endif
+
+/**
+ * Describes what was left behind in an exception context that was reset.
+ *
+ * @see e4c_context_reset
+ */
+struct e4c_reset_report {
+
+    /** The number of dangling exception blocks that were deleted. */
+    int blocks;
+
+    /** The number of leftover exceptions that were deleted, including causes. */
+    int exceptions;
+};
+
+/**
+ * Represents a pending asynchronous operation.
+ *
+ * An operation issued in one stack frame may complete in a callback that
+ * runs in a different one, such as an event loop dispatching I/O
+ * readiness. Since exceptions cannot propagate across the event loop, the
+ * callback records the failure in the operation via #e4c_operation_fail,
+ * and the continuation throws it again via #THROW_IF_FAILED.
+ *
+ * Operations MUST be zero-initialized. Successful operations never
+ * allocate memory: the record only holds a pointer that stays
+ * <tt>NULL</tt>.
+ *
+ * @note
+ * An operation is not synchronized. If it completes in a different
+ * thread, the event loop MUST hand it over to the continuation with the
+ * appropriate memory barriers, as it would do for any other result.
+ *
+ * @see THROW_IF_FAILED
+ */
+struct e4c_operation {
+
+    /** @internal The captured exception the operation failed with. */
+    struct e4c_exception * _failure;
+};
+
+#ifndef EXCEPTIONS4C_NO_RETRY
+
+/**
+ * Represents the way the delay between attempts grows.
+ *
+ * @see e4c_backoff
+ */
+enum e4c_backoff_strategy {
+
+    /** The delay doubles after each attempt, starting at the initial delay. */
+    E4C_BACKOFF_EXPONENTIAL,
+
+    /**
+     * The delay is a random number between the initial delay and three
+     * times the previous delay, so that clients that failed at once drift
+     * apart.
+     */
+    E4C_BACKOFF_DECORRELATED_JITTER
+};
+
+/**
+ * Specifies how long to wait before repeating an exception block.
+ *
+ * Both the clock and the sleep function can be replaced, so that programs
+ * can use their own time source, or avoid blocking in tests.
+ *
+ * @see RETRY_BACKOFF
+ * @see REACQUIRE_BACKOFF
+ */
+struct e4c_backoff {
+
+    /** The way the delay grows with the number of attempts. */
+    enum e4c_backoff_strategy strategy;
+
+    /** The delay before the first attempt is repeated, in milliseconds. */
+    long initial_delay;
+
+    /** The maximum delay between attempts, in milliseconds; zero for no maximum. */
+    long max_delay;
+
+    /** The maximum time, since the first attempt was repeated, after which no more attempts are made, in milliseconds; zero for no maximum. */
+    long budget;
+
+    /** A possibly-null function that returns the current time, in milliseconds; if <tt>NULL</tt>, a monotonic clock is used. */
+    long long (*clock)(void);
+
+    /** A possibly-null function that waits for a number of milliseconds; if <tt>NULL</tt>, the current thread sleeps. */
+    void (*sleep)(long milliseconds);
+};
+
+#endif
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+
+/**
+ * Represents a request to stop work that is no longer needed.
+ *
+ * A token is attached to one or more exception contexts via
+ * #e4c_set_cancellation_token, and cancelled from any thread via
+ * #e4c_cancel. Then, the next #CHECKPOINT reached by each of those
+ * contexts throws #CANCELLED, no matter how deeply nested its exception
+ * blocks are. Tasks spawned by the parallel execution module share the
+ * token of the context that spawned them; tasks spawned in a #NURSERY
+ * block get a token derived from it, which is also cancelled as soon as
+ * one of their siblings fails. Tokens derived via
+ * #e4c_derive_cancellation_token are cancelled along with their parent.
+ *
+ * ```c
+ * static struct e4c_cancellation_token token;
+ *
+ * void run_query(struct query * query) {
+ *     (void) e4c_set_cancellation_token(e4c_get_context(), &token);
+ *     TRY {
+ *         search(query);
+ *     } CATCH (CANCELLED) {
+ *         log_superseded(query, e4c_get_exception()->message);
+ *     }
+ * }
+ *
+ * void on_new_query(void) {
+ *     (void) e4c_cancel(&token, "Superseded by a newer query");
+ * }
+ * ```
+ *
+ * Tokens MUST be zero-initialized, and they MUST outlive the contexts they
+ * are attached to. Cancelling a token never allocates memory.
+ *
+ * @see CHECKPOINT
+ * @see e4c_cancel
+ */
+struct e4c_cancellation_token {
+
+    /** @internal The reason why the token was cancelled, accessed atomically; <tt>NULL</tt> if it was not. */
+    const char * _reason;
+
+    /** @internal A possibly-null pointer to the token this one derives from; cancelling it cancels this one too. */
+    struct e4c_cancellation_token * _parent;
+
+    /** @internal A possibly-null pointer to the most recently derived token. */
+    struct e4c_cancellation_token * _children;
+
+    /** @internal A possibly-null pointer to the next token derived from the same parent. */
+    struct e4c_cancellation_token * _sibling;
+
+    /** @internal The number of threads cancelling the derived tokens, or -1 if they are being changed, accessed atomically. */
+    int _state;
+};
+
+#endif
+
+/**
+ * Maps a signal to the type of the exceptions it will be turned into.
+ *
+ * @see SIGNAL_MAPPING
+ * @see e4c_map_signals
+ */
+struct e4c_signal_mapping {
+
+    /** The number of the signal. */
+    int signal_number;
+
+    /** The possibly-null type of the exceptions the signal will be turned into. */
+    const struct e4c_exception_type * exception_type;
+
+    /** The name of the exception type. */
+    const char * name;
+};
+
+/**
+ * Describes the signal an exception was thrown from.
+ *
+ * @see e4c_get_signal_info
+ */
+struct e4c_signal_info {
+
+    /** The number of the signal. */
+    int signal_number;
+
+    /** The signal code, such as <tt>SEGV_MAPERR</tt> or <tt>FPE_INTDIV</tt>. */
+    int code;
+
+    /** The faulting address, for signals that report one. */
+    void * address;
+
+    /** The offset of the faulting address within the #PROBE region, if any. */
+    size_t offset;
+};
+
+/**
+ * Represents a memory region probed by a #PROBE block.
+ *
+ * @see PROBE
+ */
+struct e4c_probe {
+
+    /** @internal The start of the probed region. */
+    const volatile void * _base;
+
+    /** @internal The size of the probed region. */
+    size_t _size;
+
+    /** @internal A possibly-null pointer to the outer probe. */
+    struct e4c_probe * _outer;
+
+    /** @internal Zero before the probed region is accessed, one while it is being accessed, two afterwards. */
+    int _stage;
+
+    /** @internal The signal that interrupted the access, if any. */
+    struct e4c_signal_info _info;
+
+    /** @internal The execution context to load when the access is interrupted. */
+    e4c_env _env;
+};
+
+/**
+ * Sets the exception context supplier.
+ *
+ * @param supplier a function that supplies the current exception context.
+ *
+ * The library relies on this [context](#e4c_context) to handle the current
+ * status of exceptions. If no supplier is provided, a default one will be used.
+ *
+ * @remark
+ * Since the default exception context does not support concurrency, this
+ * mechanism can be useful to provide a concurrent version. For example, a
+ * context supplier could return different instances, depending on which
+ * thread is active. In that case, the supplier MUST be responsible for
+ * the creation and deletion of those instances. The library already provides
+ * a thread-local supplier: #e4c_thread_context.
+ *
+ * @see e4c_context
+ * @see e4c_thread_context
+ */
+void e4c_set_context_supplier(struct e4c_context * (*supplier)(void));
+
+/**
+ * Retrieves the current exception context.
+ *
+ * @return the current exception context.
+ *
+ * @remark
+ * This function MAY be used to configure the current exception context.
+ * For example, you can set a custom handler that will be executed when
+ * the program abruptly terminates due to an uncaught exception.
+ *
+ * @see e4c_context
+ * @see e4c_set_context_supplier
+ */
+struct e4c_context * e4c_get_context(void);
+
+/**
+ * Supplies a different exception context for each thread.
+ *
+ * @return the exception context of the current thread.
+ *
+ * Pass this function to #e4c_set_context_supplier to let each thread handle
+ * exceptions on its own. The library recognizes it and retrieves the
+ * thread-local context directly, without calling through the supplier.
+ *
+ * @remark
+ * Each thread's context is created the first time it is needed, copying the
+ * handlers of the default context, so it is convenient to configure the
+ * default context before setting this supplier. When a thread exits, any
+ * exception blocks and exceptions it left behind are deleted.
+ *
+ * @see e4c_set_context_supplier
+ */
+struct e4c_context * e4c_thread_context(void);
+
+/**
+ * Switches the active exception context of the current thread.
+ *
+ * @param context a possibly-null pointer to the exception context to activate.
+ * @return the previously active exception context, or <tt>NULL</tt> if none.
+ *
+ * While a context is active, #e4c_get_context returns it directly, without
+ * calling the context supplier. Passing <tt>NULL</tt> goes back to the
+ * context supplier.
+ *
+ * This function is intended for user-space fibers (or coroutines): each
+ * fiber owns an exception context, and the scheduler activates it right
+ * before resuming the fiber, and restores the previous one when the fiber
+ * yields. That way, a fiber can yield in the middle of a #TRY block without
+ * corrupting the exception blocks of other fibers.
+ *
+ * ```c
+ * struct e4c_context * previous = e4c_switch_context(&fiber->context);
+ * swapcontext(&scheduler, &fiber->ucontext);
+ * e4c_switch_context(previous);
+ * ```
+ *
+ * Unlike #e4c_attach_context, switching contexts is unchecked: it does not
+ * record the previous context, so it MUST be undone by the caller. Any
+ * switch made while a context is attached MUST be undone before that
+ * context is detached; otherwise, the program will be abruptly terminated.
+ *
+ * @note
+ * Switching contexts takes constant time and no memory allocations.
+ *
+ * @see e4c_get_context
+ * @see e4c_attach_context
+ */
+struct e4c_context * e4c_switch_context(struct e4c_context * context);
+
+/**
+ * Attaches an exception context to the current thread.
+ *
+ * @param context the exception context to attach.
+ *
+ * Until it is detached via #e4c_detach_context, #e4c_get_context returns
+ * the attached context directly, without calling the context supplier.
+ * This allows event-driven programs that multiplex many connections on one
+ * thread to give each connection its own exception context: the event
+ * loop attaches it before running the connection's handler, and detaches
+ * it afterwards.
+ *
+ * ```c
+ * e4c_attach_context(&connection->context);
+ * handle_event(connection, event);
+ * e4c_detach_context();
+ * ```
+ *
+ * Contexts can be attached in a nested fashion; each call to
+ * #e4c_detach_context restores the context that was active when the
+ * matching call to this function was made.
+ *
+ * @note
+ * Attaching a context takes constant time and no memory allocations. Up to
+ * <tt>EXCEPTIONS4C_MAX_ATTACHED_CONTEXTS</tt> (16 by default) contexts can
+ * be nested per thread.
+ *
+ * @see e4c_detach_context
+ */
+void e4c_attach_context(struct e4c_context * context);
+
+/**
+ * Detaches the innermost exception context attached to the current thread.
+ *
+ * @return the detached exception context.
+ *
+ * The context that was active before the detached one was attached is
+ * restored. The active context MUST be the one being detached, and it MUST
+ * NOT have any exception blocks running; otherwise, the program will be
+ * abruptly terminated.
+ *
+ * @see e4c_attach_context
+ * @see e4c_switch_context
+ */
+struct e4c_context * e4c_detach_context(void);
+
+/**
+ * Represents the exhaustion of the stack of the current thread.
+ *
+ * @see e4c_handle_stack_overflow
+ */
+extern const struct e4c_exception_type STACK_OVERFLOW;
+
+/**
+ * Turns stack overflows in the current thread into exceptions.
+ *
+ * @return <tt>true</tt> if stack overflows will be handled; <tt>false</tt>
+ *   if they cannot be detected in this platform.
+ *
+ * Without an alternate signal stack, a stack overflow kills the program,
+ * since the handler for <tt>SIGSEGV</tt> has no stack to run on. This
+ * function sets up an alternate signal stack for the current thread, and
+ * installs a handler for <tt>SIGSEGV</tt> that tells stack overflows apart
+ * from other segmentation faults, by checking how close the faulting
+ * address is to the end of the stack.
+ *
+ * A stack overflow is thrown as a #STACK_OVERFLOW exception to the
+ * innermost exception block whose function has enough stack space left to
+ * handle it. The #FINALLY blocks of the exception blocks below it are not
+ * executed. Other segmentation faults are forwarded to the previous
+ * <tt>SIGSEGV</tt> handler.
+ *
+ * ```c
+ * e4c_handle_stack_overflow();
+ * TRY {
+ *     parse_document(input);
+ * } CATCH (STACK_OVERFLOW) {
+ *     reject_document(input);
+ * }
+ * ```
+ *
+ * @note
+ * This function MUST be called by every thread whose stack overflows
+ * should be handled. Calling it more than once per thread has no effect.
+ *
+ * @see STACK_OVERFLOW
+ */
+bool e4c_handle_stack_overflow(void);
+
+/**
+ * Represents the reception of a signal that was mapped to an exception.
+ *
+ * @see e4c_map_signals
+ */
+extern const struct e4c_exception_type SIGNAL_ERROR;
+
+/**
+ * Represents an invalid memory access (<tt>SIGSEGV</tt>).
+ *
+ * @see e4c_map_signals
+ */
+extern const struct e4c_exception_type SEGMENTATION_FAULT;
+
+/**
+ * Represents an access to a misaligned or nonexistent physical address
+ * (<tt>SIGBUS</tt>).
+ *
+ * @see e4c_map_signals
+ */
+extern const struct e4c_exception_type BUS_ERROR;
+
+/**
+ * Represents an erroneous arithmetic operation, such as a division by zero
+ * (<tt>SIGFPE</tt>).
+ *
+ * @see e4c_map_signals
+ */
+extern const struct e4c_exception_type ARITHMETIC_ERROR;
+
+/**
+ * Represents the execution of an illegal instruction (<tt>SIGILL</tt>).
+ *
+ * @see e4c_map_signals
+ */
+extern const struct e4c_exception_type ILLEGAL_INSTRUCTION;
+
+/**
+ * Represents a write to a pipe or socket with no readers
+ * (<tt>SIGPIPE</tt>).
+ *
+ * @see e4c_map_signals
+ */
+extern const struct e4c_exception_type BROKEN_PIPE;
+
+/**
+ * Turns signals into exceptions.
+ *
+ * @param mappings a possibly-null table of signal mappings; if
+ *   <tt>NULL</tt>, the default mappings are used.
+ * @param count the number of mappings in the table.
+ * @return <tt>true</tt> if the handlers for all the mapped signals were
+ *   installed; <tt>false</tt> otherwise.
+ *
+ * This function installs a <tt>SA_SIGINFO</tt> handler for each mapped
+ * signal. When one of them is received while an exception block is
+ * running, the handler throws a new exception of the mapped type, without
+ * allocating memory, and records the signal number, the signal code, and
+ * the faulting address, which can be retrieved via #e4c_get_signal_info.
+ *
+ * The default mappings turn <tt>SIGSEGV</tt>, <tt>SIGBUS</tt>,
+ * <tt>SIGFPE</tt>, <tt>SIGILL</tt>, and <tt>SIGPIPE</tt> into
+ * #SEGMENTATION_FAULT, #BUS_ERROR, #ARITHMETIC_ERROR, #ILLEGAL_INSTRUCTION,
+ * and #BROKEN_PIPE, all of which extend #SIGNAL_ERROR.
+ *
+ * ```c
+ * e4c_map_signals(NULL, 0);
+ * TRY_SIGNALSAFE {
+ *     value = *pointer;
+ * } CATCH (SEGMENTATION_FAULT) {
+ *     const struct e4c_signal_info * info = e4c_get_signal_info(e4c_get_exception());
+ *     printf("Bad address: %p\n", info->address);
+ * }
+ * ```
+ *
+ * The exception is thrown to the exception context of the thread the
+ * handler runs in. Synchronous signals, such as <tt>SIGSEGV</tt>, are
+ * always delivered to the faulting thread, so each thread catches its own
+ * faults. Signals received when no exception block is running, or whose
+ * mapping has a <tt>NULL</tt> exception type, are forwarded to the action
+ * that was in place before they were mapped.
+ *
+ * @note
+ * This function SHOULD be called at program startup, before other threads
+ * are created. Exceptions thrown from mapped signals SHOULD be caught by
+ * #TRY_SIGNALSAFE blocks, so that the signal mask is restored.
+ *
+ * @see SIGNAL_MAPPING
+ * @see e4c_get_signal_info
+ */
+bool e4c_map_signals(const struct e4c_signal_mapping * mappings, int count);
+
+/**
+ * Retrieves the signal an exception was thrown from.
+ *
+ * @param exception the exception.
+ * @return a possibly-null pointer to the information about the signal; it
+ *   is <tt>NULL</tt> unless the exception was thrown from a signal mapped
+ *   via #e4c_map_signals or from a stack overflow.
+ *
+ * The information lives in the exception itself, so it is only valid as
+ * long as the exception is; it is not kept by #e4c_capture.
+ *
+ * @see e4c_map_signals
+ */
+const struct e4c_signal_info * e4c_get_signal_info(const struct e4c_exception * exception);
+
+/**
+ * Represents a failed access to a memory-mapped file.
+ *
+ * @see PROBE
+ */
+extern const struct e4c_exception_type MAPPED_IO_ERROR;
+
+/**
+ * Represents the expiration of the deadline of a #TRY_WITHIN block.
+ *
+ * @see TRY_WITHIN
+ */
+extern const struct e4c_exception_type DEADLINE_EXCEEDED;
+
+/**
+ * Keeps expired deadlines from interrupting the current thread until
+ * #e4c_resume_deadlines is called.
+ *
+ * Code running inside a #TRY_WITHIN block that is not safe to interrupt,
+ * such as code that acquires locks or allocates memory, MUST be enclosed
+ * between this function and #e4c_resume_deadlines. Calls can be nested.
+ *
+ * @note
+ * Deferring deadlines takes constant time and no system calls.
+ *
+ * @see e4c_resume_deadlines
+ * @see TRY_WITHIN
+ */
+void e4c_defer_deadlines(void);
+
+/**
+ * Lets expired deadlines interrupt the current thread again, once every
+ * call to #e4c_defer_deadlines has been matched.
+ *
+ * A deadline that expired in the meantime is thrown shortly after.
+ *
+ * @pre
+ *   - Deadlines MUST have been deferred by a matching call to
+ *     #e4c_defer_deadlines; otherwise, the program will be abruptly
+ *     terminated.
+ *   - The code between both calls MUST NOT throw exceptions; otherwise,
+ *     deadlines will stay deferred.
+ *
+ * @see e4c_defer_deadlines
+ */
+void e4c_resume_deadlines(void);
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+
+/**
+ * Represents the cancellation of the work being done by an exception context.
+ *
+ * The message of a #CANCELLED exception is the reason passed to
+ * #e4c_cancel.
+ *
+ * @see CHECKPOINT
+ */
+extern const struct e4c_exception_type CANCELLED;
+
+#endif
+
+/**
+ * Resets an exception context to its pristine state.
+ *
+ * @param context the exception context to reset.
+ * @return a report of the dangling blocks and leftover exceptions that were
+ *   deleted.
+ *
+ * Exception blocks exited improperly (via <tt>goto</tt>, <tt>break</tt>,
+ * <tt>continue</tt>, or <tt>return</tt>) are left dangling in the context,
+ * along with their exceptions. Long-running programs, such as servers, MAY
+ * call this function between requests, so that leaks are detected as soon
+ * as they happen, instead of at program exit. The handlers of the context
+ * are preserved, but its cancellation token is detached, so that a request
+ * cannot cancel the next one.
+ *
+ * ```c
+ * while (accept_request(&request)) {
+ *     handle_request(&request);
+ *     struct e4c_reset_report leaks = e4c_context_reset(e4c_get_context());
+ *     if (leaks.blocks > 0) {
+ *         log_leak(&request, leaks.blocks, leaks.exceptions);
+ *     }
+ * }
+ * ```
+ *
+ * @note
+ * Resetting a pristine context takes constant time. Otherwise, it takes
+ * time proportional to the number of dangling blocks.
+ *
+ * Only the state owned by the context is reset. Exception blocks abandoned
+ * by [stack overflows](#e4c_handle_stack_overflow) belong to the thread
+ * they overflowed in, which deletes them as soon as it moves on.
+ *
+ * @pre
+ *   - The context MUST NOT be [attached](#e4c_attach_context) to the
+ *     current thread; otherwise, the program will be abruptly terminated.
+ *
+ * @warning
+ * This function MUST NOT be called from an exception block of the context
+ * being reset, nor while the context is being used by another thread.
+ */
+struct e4c_reset_report e4c_context_reset(struct e4c_context * context);
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+
+/**
+ * Attaches a cancellation token to an exception context.
+ *
+ * @param context the exception context.
+ * @param token a possibly-null pointer to the cancellation token to attach; if <tt>NULL</tt>, the current one is detached.
+ * @return the cancellation token that was previously attached to the context, or <tt>NULL</tt>.
+ *
+ * The token applies to every exception block of the context, including the
+ * ones already started.
+ *
+ * @warning
+ * This function MUST be called from the thread the context belongs to.
+ *
+ * @see e4c_cancellation_token
+ */
+struct e4c_cancellation_token * e4c_set_cancellation_token(struct e4c_context * context, struct e4c_cancellation_token * token);
+
+/**
+ * Retrieves the cancellation token attached to an exception context.
+ *
+ * @param context the exception context.
+ * @return the cancellation token attached to the context, or <tt>NULL</tt>.
+ *
+ * @see e4c_set_cancellation_token
+ */
+struct e4c_cancellation_token * e4c_get_cancellation_token(const struct e4c_context * context);
+
+/**
+ * Cancels a cancellation token.
+ *
+ * @param token the cancellation token to cancel.
+ * @param reason a possibly-null string that describes why the token was cancelled.
+ * @return <tt>true</tt> if the token was cancelled by this call; <tt>false</tt> if it was already cancelled.
+ *
+ * This function MAY be called from any thread, including signal handlers.
+ * The reason is not copied, so it MUST remain valid as long as the token is
+ * in use. Only the first reason is kept.
+ *
+ * @see CHECKPOINT
+ */
+bool e4c_cancel(struct e4c_cancellation_token * token, const char * reason);
+
+/**
+ * Retrieves the reason why a cancellation token was cancelled.
+ *
+ * @param token a possibly-null pointer to the cancellation token.
+ * @return the reason why the token, or the token it derives from, was cancelled, or <tt>NULL</tt> if neither was.
+ *
+ * @see e4c_cancel
+ */
+const char * e4c_get_cancellation_reason(const struct e4c_cancellation_token * token);
 
-    /** The name of the function that threw this exception, or <tt>NULL</tt> if <tt>NDEBUG</tt> is defined. */
-    const char * function;
+/**
+ * Derives a cancellation token from another one.
+ *
+ * @param token the cancellation token that will derive from the parent.
+ * @param parent a possibly-null pointer to the cancellation token to derive from.
+ *
+ * Cancelling the parent cancels the derived token too, with the same
+ * reason, and so does deriving from a parent that is already cancelled.
+ * Cancelling the derived token does not cancel the parent. Cancellation is
+ * propagated when the parent is cancelled, so checkpoints never need to
+ * look past the token of their context.
+ *
+ * @pre
+ *   - The derived token MUST be released via
+ *     #e4c_release_cancellation_token before it goes out of scope;
+ *     otherwise, the parent will be left pointing to it.
+ *
+ * @see e4c_release_cancellation_token
+ */
+void e4c_derive_cancellation_token(struct e4c_cancellation_token * token, struct e4c_cancellation_token * parent);
 
-    /** The value of [errno](https://devdocs.io/c/error/errno) at the time this exception was thrown. */
-    int error_number;
+/**
+ * Stops a derived cancellation token from being cancelled along with its
+ * parent.
+ *
+ * @param token the cancellation token to release.
+ *
+ * @see e4c_derive_cancellation_token
+ */
+void e4c_release_cancellation_token(struct e4c_cancellation_token * token);
 
-    /** A possibly-null pointer to the current exception when this exception was thrown. */
-    struct e4c_exception * cause;
+#endif
 
-    /** A possibly-null pointer to custom data associated to this exception. */
-    void * data;
-};
+#ifndef EXCEPTIONS4C_NO_REGISTRY
 
 /**
- * Contains the configuration and the current status of exceptions.
+ * Enables the registry of exception contexts.
  *
- * This structure allows you to configure the way the exception system behaves:
+ * The registry keeps track of exception contexts so that any thread can
+ * retrieve aggregated statistics via #e4c_get_statistics. Once enabled, the
+ * default context and every new thread-local context are registered
+ * automatically; thread-local contexts are unregistered when their threads
+ * exit.
  *
- * - Set <strong>uncaught_handler</strong> to a function that will be executed when an exception reaches the top level of the program.
- * - Set <strong>termination_handler</strong> to a function that will be executed when the program abruptly terminates due to an uncaught exception.
- * - Set <strong>initialize_exception</strong> to a function that will be executed whenever an exception is thrown. This function MAY create and assign custom data to the exception.
- * - Set <strong>finalize_exception</strong> to a function that will be executed whenever an exception is deleted. This function MAY delete custom data previously created.
+ * @note
+ * A thread-local context is registered the first time its thread uses
+ * exceptions, which MAY allocate a registry entry. Entries are never freed,
+ * but reused by contexts registered later. Threads that must not allocate
+ * while they run SHOULD call #e4c_get_context once beforehand.
  *
- * @see e4c_get_context
- * @see e4c_set_context_supplier
+ * @note
+ * Contexts that are not registered skip all registry bookkeeping; registered
+ * ones only read the clock at the start of an exception block once some
+ * thread took snapshots via #e4c_snapshot_context or #e4c_watchdog_scan.
+ *
+ * @see e4c_register_context
+ * @see e4c_get_statistics
  */
-struct e4c_context {
-
-    /**
-     * @internal The current exception block of the running program.
-     */
-    void * _innermost_block;
+void e4c_enable_context_registry(void);
 
-    /** The function to execute in the event of an uncaught exception */
-    void (*uncaught_handler)(const struct e4c_exception * exception);
-
-    /** The function to execute in the event of program termination. */
-    void (*termination_handler)();
+/**
+ * Links an exception context to the registry.
+ *
+ * @param context the exception context to register.
+ *
+ * Custom context suppliers MAY call this function to register the contexts
+ * they create. Registering a context that is already registered has no
+ * effect. Registration is lock-free and MAY happen while other threads
+ * retrieve statistics.
+ *
+ * @see e4c_unregister_context
+ */
+void e4c_register_context(struct e4c_context * context);
 
-    /** The function to execute whenever a new exception is thrown */
-    void (*initialize_exception)(struct e4c_exception * exception);
+/**
+ * Unlinks an exception context from the registry.
+ *
+ * @param context the exception context to unregister.
+ *
+ * Custom context suppliers SHOULD call this function before deleting a
+ * context they registered.
+ *
+ * @see e4c_register_context
+ */
+void e4c_unregister_context(struct e4c_context * context);
 
-    /** The function to execute whenever an exception is destroyed */
-    void (*finalize_exception)(const struct e4c_exception * exception);
-};
+/**
+ * Retrieves aggregated statistics of the registered exception contexts.
+ *
+ * @return the sum of the counters of all registered contexts.
+ *
+ * This function MAY be called from any thread. It never blocks the threads
+ * that are using exceptions, so the statistics are an approximate snapshot
+ * while those threads are running.
+ *
+ * @see e4c_statistics
+ * @see e4c_enable_context_registry
+ */
+struct e4c_statistics e4c_get_statistics(void);
 
 /**
- * Sets the exception context supplier.
+ * Takes a snapshot of the exception blocks that are open in a registered context.
  *
- * @param supplier a function that supplies the current exception context.
+ * @param context the registered exception context.
+ * @param snapshots the array to fill, from the outermost exception block to the innermost one.
+ * @param max_snapshots the length of the array.
+ * @return the number of exception blocks that are open in the context; <tt>0</tt> if the context is not registered.
  *
- * The library relies on this [context](#e4c_context) to handle the current
- * status of exceptions. If no supplier is provided, a default one will be used.
+ * This function MAY be called from any thread, such as a watchdog that
+ * looks for hung workers. Each registered context publishes the stage of
+ * its exception blocks, along with where and when they started, through a
+ * sequence lock: the snapshot is consistent, yet the thread that owns the
+ * context is never blocked, no matter how often it is taken.
  *
- * @remark
- * Since the default exception context does not support concurrency, this
- * mechanism can be useful to provide a concurrent version. For example, a
- * context supplier could return different instances, depending on which
- * thread is active. In that case, the supplier MUST be responsible for
- * the creation and deletion of those instances.
+ * ```c
+ * struct e4c_block_snapshot blocks[8];
+ * int depth = e4c_snapshot_context(worker_context, blocks, 8);
+ * for (int index = 0; index < depth && index < 8; index++) {
+ *     printf("%s:%d (%ld ms)\n", blocks[index].file, blocks[index].line, blocks[index].milliseconds);
+ * }
+ * ```
  *
- * @see e4c_context
+ * @note
+ * Only the outermost exception blocks of each context are published (16
+ * by default; see <tt>EXCEPTIONS4C_MAX_WATCHED_BLOCKS</tt>). The context MUST be registered before its
+ * exception blocks start, and it MUST remain registered while the snapshot
+ * is taken.
+ *
+ * @see e4c_watchdog_scan
  */
-void e4c_set_context_supplier(struct e4c_context * (*supplier)(void));
+int e4c_snapshot_context(const struct e4c_context * context, struct e4c_block_snapshot snapshots[], int max_snapshots);
 
 /**
- * Retrieves the current exception context.
+ * Reports the exception blocks that have been open for too long in any registered context.
  *
- * @return the current exception context.
+ * @param milliseconds the time after which an exception block is reported.
+ * @param report the function to call for each exception block that has been open for too long.
+ * @param argument a possibly-null pointer to pass to every call to <tt>report</tt>.
+ * @return the number of exception blocks that were reported.
  *
- * @remark
- * This function MAY be used to configure the current exception context.
- * For example, you can set a custom handler that will be executed when
- * the program abruptly terminates due to an uncaught exception.
+ * A watchdog thread MAY call this function periodically. Every registered
+ * context is [snapshotted](#e4c_snapshot_context), and the exception blocks
+ * that started more than <tt>milliseconds</tt> ago are reported, from the
+ * outermost to the innermost one.
  *
- * @see e4c_context
- * @see e4c_set_context_supplier
+ * @see e4c_snapshot_context
  */
-struct e4c_context * e4c_get_context(void);
+int e4c_watchdog_scan(long milliseconds, void (*report)(const struct e4c_context * context, const struct e4c_block_snapshot * block, void * argument), void * argument);
+
+#endif
 
 /**
  * Retrieves the last exception that was thrown.
@@ -713,6 +2583,84 @@ const struct e4c_exception * e4c_get_exception(void);
  */
 bool e4c_is_uncaught(void);
 
+/**
+ * Captures the current exception so that it can be thrown in another thread.
+ *
+ * @return a self-contained copy of the current exception and its causes, or
+ *   <tt>NULL</tt> if there is no current exception.
+ *
+ * The copy is allocated as a single block of memory and does not refer to
+ * the current exception context. It MAY be passed to #THROW_CAPTURED, or
+ * deleted via <tt>free</tt> if it is no longer needed. Capturing an
+ * exception never takes a lock.
+ *
+ * @note
+ * Custom [data](#e4c_exception.data) is not captured, since it belongs to
+ * the context where the exception was thrown.
+ *
+ * @see THROW_CAPTURED
+ */
+struct e4c_exception * e4c_capture(void);
+
+/**
+ * Makes an asynchronous operation fail with the current exception.
+ *
+ * @param operation a pointer to the operation that failed.
+ * @return <tt>true</tt> if the current exception was recorded; <tt>false</tt>
+ *   if there is no current exception, or the operation had already failed.
+ *
+ * This function SHOULD be called from a #CATCH or #CATCH_ALL block of the
+ * callback that completed the operation. The current exception is captured
+ * (see #e4c_capture) so that it can be thrown again when the continuation
+ * of the operation runs. Only the first failure of an operation is kept.
+ *
+ * @see e4c_operation
+ * @see THROW_IF_FAILED
+ */
+bool e4c_operation_fail(struct e4c_operation * operation);
+
+/**
+ * Takes the captured exception an asynchronous operation failed with.
+ *
+ * @param operation a pointer to the operation.
+ * @return the captured exception, or <tt>NULL</tt> if the operation did not
+ *   fail.
+ *
+ * The operation is reset, so that it can be reused. The caller takes
+ * ownership of the captured exception: it MAY be passed to #THROW_CAPTURED,
+ * or deleted via <tt>free</tt>.
+ *
+ * @see THROW_IF_FAILED
+ */
+struct e4c_exception * e4c_operation_take(struct e4c_operation * operation);
+
+/**
+ * Registers an exception type, so that it can be caught in constant time.
+ *
+ * @param type the exception type to register.
+ * @return <tt>false</tt> if the supertypes of the exception type contain a cycle; <tt>true</tt> otherwise.
+ *
+ * The [displays](#e4c_type_display) of the exception type and its
+ * supertypes (if any) will be filled with their precomputed ancestors.
+ * Exception types without a display can be caught anyway, by walking
+ * through their supertypes.
+ *
+ * ```c
+ * int main(void) {
+ *   e4c_register_type(&FILE_NOT_FOUND);
+ *   e4c_register_type(&PERMISSION_DENIED);
+ *   ...
+ * }
+ * ```
+ *
+ * @remark
+ * Exception types SHOULD be registered at program startup, before any
+ * of them is thrown concurrently.
+ *
+ * @see e4c_type_display
+ */
+bool e4c_register_type(const struct e4c_exception_type * type);
+
 /**
  * @internal
  * @brief Starts a new exception block.
@@ -776,6 +2724,20 @@ bool e4c_acquire(const char * file, int line, const char * function);
  */
 bool e4c_try(const char * file, int line, const char * function);
 
+/**
+ * @internal
+ * @brief Checks if the current exception block is in the #TRYING stage, and starts its deadline if so.
+ *
+ * @param milliseconds the time the block is allowed to run.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @return <tt>true</tt> if the current exception block is in the #TRYING stage; <tt>false</tt> otherwise.
+ *
+ * @warning This function SHOULD be called only via #TRY_WITHIN.
+ */
+bool e4c_try_within(long milliseconds, const char * file, int line, const char * function);
+
 /**
  * @internal
  * @brief Checks if the current exception block is in the #DISPOSING stage.
@@ -806,6 +2768,53 @@ bool e4c_dispose(const char * file, int line, const char * function);
  */
 bool e4c_catch(const struct e4c_exception_type * type, const char * file, int line, const char * function);
 
+/**
+ * @internal
+ * @brief Checks if the current exception can be handled by any of the supplied types.
+ *
+ * @param types the types of exceptions to handle.
+ * @param count the number of types.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @return <tt>true</tt> if:
+ *   - the current exception block is in the #CATCHING stage, AND
+ *   - any of the supplied <tt>types</tt> is either <tt>NULL</tt> or a supertype of the thrown exception.
+ *   <tt>false</tt> otherwise.
+ *
+ * @warning This function SHOULD be called only via #CATCH_ANY.
+ */
+bool e4c_catch_any(const struct e4c_exception_type * const types[], int count, const char * file, int line, const char * function);
+
+/**
+ * @internal
+ * @brief Checks if the current exception belongs to the supplied family.
+ *
+ * @param family the family of exceptions to handle.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @return <tt>true</tt> if:
+ *   - the current exception block is in the #CATCHING stage, AND
+ *   - the type of the thrown exception, or any of its supertypes, belongs to the supplied family.
+ *   <tt>false</tt> otherwise.
+ *
+ * @warning This function SHOULD be called only via #CATCH_SWITCH.
+ */
+bool e4c_catch_family(const struct e4c_exception_family * family, const char * file, int line, const char * function);
+
+/**
+ * @internal
+ * @brief Retrieves the identifier of the current exception within the supplied family.
+ *
+ * @param family the family of exceptions.
+ * @return the identifier of the type of the current exception (or its closest supertype) within the supplied family,
+ *   or zero if none of them belongs to the family.
+ *
+ * @warning This function SHOULD be called only via #CATCH_SWITCH.
+ */
+int e4c_get_exception_id(const struct e4c_exception_family * family);
+
 /**
  * @internal
  * @brief Checks if the current exception block is in the #FINALIZING stage.
@@ -836,6 +2845,92 @@ bool e4c_finally(const char * file, int line, const char * function);
  */
 e4c_env * e4c_throw(const struct e4c_exception_type * type, const char * name, const char * file, int line, const char * function, const char * format, ...);
 
+/**
+ * @internal
+ * @brief Throws a preallocated exception from a signal handler.
+ *
+ * @param type the type of exception to throw.
+ * @param name the name of the exception type.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @param message the error message, which will not be formatted.
+ * @return the execution context of the current exception block.
+ *
+ * @warning This function SHOULD be called only via #THROW_FROM_SIGNAL.
+ */
+e4c_env * e4c_throw_from_signal(const struct e4c_exception_type * type, const char * name, const char * file, int line, const char * function, const char * message);
+
+/**
+ * @internal
+ * @brief Enters or exits a probed memory region.
+ *
+ * @param probe the probed memory region.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @return <tt>true</tt> if the region was entered; <tt>false</tt> if it was exited.
+ *
+ * If the access to the region was interrupted by a signal, a #MAPPED_IO_ERROR is thrown.
+ *
+ * @warning This function SHOULD be called only via #PROBE.
+ */
+bool e4c_probe_next(struct e4c_probe * probe, const char * file, int line, const char * function);
+
+#ifndef EXCEPTIONS4C_NO_CANCELLATION
+
+/**
+ * @internal
+ * @brief Throws #CANCELLED if the cancellation token of the current exception context has been cancelled.
+ *
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ *
+ * @warning This function SHOULD be called only via #CHECKPOINT.
+ */
+void e4c_checkpoint(const char * file, int line, const char * function);
+
+/**
+ * @internal
+ * @brief Determines whether the cancellation token of an exception context may have been cancelled.
+ *
+ * @param context a possibly-null pointer to the exception context.
+ * @return <tt>true</tt> if #e4c_checkpoint needs to be called; <tt>false</tt> otherwise.
+ *
+ * @warning This function SHOULD be called only via #CHECKPOINT.
+ */
+static inline bool e4c_may_be_cancelled(const struct e4c_context * context) {
+    if (context == NULL) {
+        /* let the library report the misbehaving context supplier */
+        return true;
+    }
+    const struct e4c_cancellation_token * token = context->_cancellation_token;
+#if defined(__GNUC__) || defined(__clang__)
+    return token != NULL && __atomic_load_n(&token->_reason, __ATOMIC_RELAXED) != NULL;
+#else
+    return token != NULL && *(const char * const volatile *) &token->_reason != NULL;
+#endif
+}
+
+#endif
+
+/**
+ * @internal
+ * @brief Throws a captured exception.
+ *
+ * @param exception the captured exception to throw.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @return the execution context of the current exception block.
+ *
+ * @warning This function SHOULD be called only via #THROW_CAPTURED.
+ */
+e4c_env * e4c_rethrow_captured(struct e4c_exception * exception, const char * file, int line, const char * function);
+
+#ifndef EXCEPTIONS4C_NO_RETRY
+
 /**
  * @internal
  * @brief Restarts an exception block.
@@ -855,6 +2950,56 @@ e4c_env * e4c_throw(const struct e4c_exception_type * type, const char * name, c
  */
 e4c_env * e4c_restart(bool should_reacquire, int max_attempts, const struct e4c_exception_type * type, const char * name, const char * file, int line, const char * function, const char * format, ...);
 
+/**
+ * @internal
+ * @brief Restarts an exception block after waiting according to a backoff policy.
+ *
+ * @param should_reacquire if <tt>true</tt>, the exception block will restart in the #ACQUIRING stage; otherwise it will start in the #TRYING stage.
+ * @param max_attempts the maximum number of attempts.
+ * @param policy the backoff policy.
+ * @param type the type of exception to throw.
+ * @param name the name of the exception type.
+ * @param file the name of the source code file that is calling this function.
+ * @param line the number of line that is calling this function.
+ * @param function the name of the function that is calling this function.
+ * @param format the error message.
+ * @param ... an optional list of arguments that will be formatted according to <tt>format</tt>.
+ * @return the execution context of the current exception block.
+ *
+ * @warning This function SHOULD be called only via #RETRY_BACKOFF or #REACQUIRE_BACKOFF.
+ */
+e4c_env * e4c_restart_backoff(bool should_reacquire, int max_attempts, const struct e4c_backoff * policy, const struct e4c_exception_type * type, const char * name, const char * file, int line, const char * function, const char * format, ...);
+
+#endif
+
+/**
+ * @internal
+ * @brief Identifies the backend and the feature profile the library was compiled with.
+ *
+ * @see EXCEPTIONS4C_ABI
+ */
+extern const int EXCEPTIONS4C_ABI;
+
+/** @internal References the ABI symbol, so that a program compiled with a different backend or feature profile fails to link. */
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((__used__))
+#endif
+static const int * const exceptions4c_abi = &EXCEPTIONS4C_ABI;
+
+#if EXCEPTIONS4C_BACKEND == EXCEPTIONS4C_BACKEND_BUILTIN
+
+/**
+ * @internal
+ * @brief Loads the supplied execution context.
+ *
+ * @param env the execution context to load.
+ *
+ * @warning This function SHOULD be called only via #EXCEPTIONS4C_LONG_JUMP.
+ */
+__attribute__((__noreturn__)) void e4c_long_jump(e4c_env * env);
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
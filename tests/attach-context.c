@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "testing.h"
+
+#define CONNECTIONS 3
+
+static void handle_event(int);
+static struct e4c_context connections[CONNECTIONS];
+static volatile int caught[CONNECTIONS];
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests that each connection can have its own attached exception context.
+ */
+int main(void) {
+    struct e4c_context * default_context = e4c_get_context();
+
+    /* nested contexts */
+    e4c_attach_context(&connections[0]);
+    TEST_ASSERT_PTR_EQUALS(e4c_get_context(), &connections[0]);
+    e4c_attach_context(&connections[1]);
+    TEST_ASSERT_PTR_EQUALS(e4c_get_context(), &connections[1]);
+    TEST_ASSERT_PTR_EQUALS(e4c_detach_context(), &connections[1]);
+    TEST_ASSERT_PTR_EQUALS(e4c_get_context(), &connections[0]);
+    TEST_ASSERT_PTR_EQUALS(e4c_detach_context(), &connections[0]);
+    TEST_ASSERT_PTR_EQUALS(e4c_get_context(), default_context);
+
+    /* an event loop that attaches each connection's context while the main one is busy */
+    TRY {
+        for (int event = 0; event < CONNECTIONS * 2; event++) {
+            handle_event(event % CONNECTIONS);
+            TEST_ASSERT_PTR_EQUALS(e4c_get_context(), default_context);
+            TEST_ASSERT_NULL(e4c_get_exception());
+        }
+    } FINALLY {
+        TEST_ASSERT_NOT_NULL(default_context->_innermost_block);
+    }
+
+    for (int connection = 0; connection < CONNECTIONS; connection++) {
+        TEST_ASSERT_INT_EQUALS(caught[connection], 2);
+        TEST_ASSERT_NULL(connections[connection]._innermost_block);
+    }
+    TEST_PASS;
+}
+
+static void handle_event(const int connection) {
+    e4c_attach_context(&connections[connection]);
+    TRY {
+        TEST_ASSERT_PTR_EQUALS(e4c_get_context(), &connections[connection]);
+        THROW(OOPS, "Connection %d", connection);
+    } CATCH (OOPS) {
+        caught[connection]++;
+    }
+    (void) e4c_detach_context();
+}
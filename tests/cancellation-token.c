@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <exceptions4c-parallel.h>
+#include "testing.h"
+
+static void * cancel_later(void *);
+static void loop_until_cancelled(void *);
+static atomic_int started = 0;
+static atomic_int cancelled = 0;
+static struct e4c_cancellation_token token;
+
+/**
+ * Tests that checkpoints throw CANCELLED once the cancellation token of the context is cancelled.
+ */
+int main(void) {
+    volatile bool caught = false; /* NOSONAR */
+    pthread_t thread;
+
+    e4c_set_context_supplier(e4c_thread_context);
+
+    /* checkpoints without a token, or with a token not cancelled yet, do nothing */
+    CHECKPOINT();
+    TEST_ASSERT_NULL(e4c_set_cancellation_token(e4c_get_context(), &token));
+    TEST_ASSERT_PTR_EQUALS(e4c_get_cancellation_token(e4c_get_context()), &token);
+    TEST_ASSERT_NULL(e4c_get_cancellation_reason(&token));
+    CHECKPOINT();
+
+    /* the token is cancelled from another thread while nested blocks are running */
+    TEST_ASSERT_INT_EQUALS(pthread_create(&thread, NULL, cancel_later, NULL), 0);
+    TRY {
+        TRY {
+            loop_until_cancelled(NULL);
+        } FINALLY {
+            TEST_ASSERT(e4c_is_uncaught());
+        }
+    } CATCH (CANCELLED) {
+        caught = true;
+        TEST_ASSERT_STR_EQUALS(e4c_get_exception()->message, "Superseded");
+    }
+    TEST_ASSERT_INT_EQUALS(pthread_join(thread, NULL), 0);
+    TEST_ASSERT(caught);
+
+    /* only the first reason is kept */
+    TEST_ASSERT_FALSE(e4c_cancel(&token, "Ignored"));
+    TEST_ASSERT_STR_EQUALS(e4c_get_cancellation_reason(&token), "Superseded");
+
+    /* tasks share the token of the context that spawned them */
+    struct e4c_cancellation_token parent = {0};
+    (void) e4c_set_cancellation_token(e4c_get_context(), &parent);
+    atomic_store(&started, 0);
+    NURSERY {
+        SPAWN(loop_until_cancelled, NULL);
+        SPAWN(loop_until_cancelled, NULL);
+        while (atomic_load(&started) < 2) {
+            continue;
+        }
+        TEST_ASSERT_TRUE(e4c_cancel(&parent, NULL));
+    } CATCH (CANCELLED) {
+        TEST_ASSERT_STR_EQUALS(e4c_get_exception()->message, "Cancelled");
+    }
+    TEST_ASSERT_INT_EQUALS(atomic_load(&cancelled), 3);
+
+    TEST_ASSERT_PTR_EQUALS(e4c_set_cancellation_token(e4c_get_context(), NULL), &parent);
+    CHECKPOINT();
+
+    /* cancellation is propagated to derived tokens, so checkpoints only look at the token of their context */
+    struct e4c_cancellation_token root = {0};
+    struct e4c_cancellation_token child = {0};
+    struct e4c_cancellation_token grandchild = {0};
+    struct e4c_cancellation_token released = {0};
+    e4c_derive_cancellation_token(&child, &root);
+    e4c_derive_cancellation_token(&grandchild, &child);
+    e4c_derive_cancellation_token(&released, &root);
+    e4c_release_cancellation_token(&released);
+    TEST_ASSERT_TRUE(e4c_cancel(&root, "Shutting down"));
+    TEST_ASSERT_STR_EQUALS(e4c_get_cancellation_reason(&grandchild), "Shutting down");
+    TEST_ASSERT_NULL(e4c_get_cancellation_reason(&released));
+    (void) e4c_set_cancellation_token(e4c_get_context(), &grandchild);
+    caught = false;
+    TRY {
+        CHECKPOINT();
+    } CATCH (CANCELLED) {
+        caught = true;
+    }
+    TEST_ASSERT(caught);
+    (void) e4c_set_cancellation_token(e4c_get_context(), NULL);
+
+    /* tokens derived from a cancelled token are cancelled right away */
+    e4c_derive_cancellation_token(&released, &root);
+    TEST_ASSERT_STR_EQUALS(e4c_get_cancellation_reason(&released), "Shutting down");
+    e4c_release_cancellation_token(&released);
+    e4c_release_cancellation_token(&grandchild);
+    e4c_release_cancellation_token(&child);
+    TEST_PASS;
+}
+
+static void * cancel_later(void * argument) {
+    (void) argument;
+    while (atomic_load(&started) == 0) {
+        continue;
+    }
+    (void) e4c_cancel(&token, "Superseded");
+    return NULL;
+}
+
+static void loop_until_cancelled(void * argument) {
+    (void) argument;
+    atomic_fetch_add(&started, 1);
+    TRY {
+        for (;;) {
+            CHECKPOINT();
+        }
+    } FINALLY {
+        atomic_fetch_add(&cancelled, 1);
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+static void * run_worker(void *);
+static void count_finalized(const struct e4c_exception *);
+static volatile int finalized = 0;
+static const struct e4c_exception_type CAUSE = {NULL, "Cause"};
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests that an exception captured in a worker thread can be thrown in the joining thread.
+ */
+int main(void) {
+    volatile bool caught = false; /* NOSONAR */
+
+    e4c_set_context_supplier(e4c_thread_context);
+    e4c_get_context()->finalize_exception = count_finalized;
+
+    TEST_ASSERT_NULL(e4c_capture());
+
+    pthread_t worker;
+    struct e4c_exception * captured = NULL;
+    TEST_ASSERT_INT_EQUALS(pthread_create(&worker, NULL, run_worker, NULL), 0);
+    TEST_ASSERT_INT_EQUALS(pthread_join(worker, (void **) &captured), 0);
+    TEST_ASSERT_NOT_NULL(captured);
+
+    TRY {
+        THROW_CAPTURED(captured);
+    } CATCH (OOPS) {
+        caught = true;
+        const struct e4c_exception * exception = e4c_get_exception();
+        TEST_ASSERT_PTR_EQUALS(exception, captured);
+        TEST_ASSERT_STR_EQUALS(exception->name, "OOPS");
+        TEST_ASSERT_STR_EQUALS(exception->message, "Oops 123");
+        TEST_ASSERT_NOT_NULL(exception->cause);
+        TEST_ASSERT_PTR_EQUALS(exception->cause->type, &CAUSE);
+        TEST_ASSERT_STR_EQUALS(exception->cause->message, "Cause");
+        TEST_ASSERT_NULL(exception->cause->cause);
+    }
+
+    TEST_ASSERT(caught);
+    TEST_ASSERT_INT_EQUALS(finalized, 2);
+    TEST_PASS;
+}
+
+static void * run_worker(void * _) {
+    (void) _;
+    struct e4c_exception * volatile captured = NULL; /* NOSONAR */
+    TRY {
+        TRY {
+            THROW(CAUSE, NULL);
+        } CATCH (CAUSE) {
+            THROW(OOPS, "Oops %d", 123);
+        }
+    } CATCH (OOPS) {
+        captured = e4c_capture();
+    }
+    return captured;
+}
+
+static void count_finalized(const struct e4c_exception * _) {
+    (void) _;
+    finalized++;
+}
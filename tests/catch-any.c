@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "testing.h"
+
+static const struct e4c_exception_type ERROR = {NULL, "Error"};
+static const struct e4c_exception_type IO_ERROR = {&ERROR, "I/O error"};
+static const struct e4c_exception_type FILE_ERROR = {&IO_ERROR, "File error"};
+static const struct e4c_exception_type NETWORK_ERROR = {&ERROR, "Network error"};
+static const struct e4c_exception_type PARSE_ERROR = {NULL, "Parse error"};
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests macro CATCH_ANY.
+ */
+int main(void) {
+    volatile int caught = 0; /* NOSONAR */
+
+    TRY {
+        THROW(FILE_ERROR, NULL);
+    } CATCH_ANY (NETWORK_ERROR, PARSE_ERROR) {
+        TEST_FAIL("Caught an unrelated type %s:%d\n", __FILE__, __LINE__);
+    } CATCH_ANY (NETWORK_ERROR, IO_ERROR, PARSE_ERROR) {
+        TEST_ASSERT_PTR_EQUALS(e4c_get_exception()->type, &FILE_ERROR);
+        caught++;
+    }
+
+    TRY {
+        TRY {
+            THROW(OOPS, NULL);
+        } CATCH_ANY (ERROR, IO_ERROR, FILE_ERROR, NETWORK_ERROR, PARSE_ERROR, ERROR, IO_ERROR, FILE_ERROR,
+                     NETWORK_ERROR, PARSE_ERROR, ERROR, IO_ERROR, FILE_ERROR, NETWORK_ERROR, PARSE_ERROR, ERROR) {
+            TEST_FAIL("Caught an unrelated type %s:%d\n", __FILE__, __LINE__);
+        }
+    } CATCH_ANY (OOPS) {
+        caught++;
+    }
+
+    /* a null type handles any exception, just like it does in e4c_catch */
+    TRY {
+        THROW(OOPS, NULL);
+    } else if (e4c_catch_any((const struct e4c_exception_type * const []) {&NETWORK_ERROR, NULL}, 2, __FILE__, __LINE__, __func__)) {
+        caught++;
+    }
+
+    TEST_ASSERT_INT_EQUALS(caught, 3);
+    TEST_PASS;
+}
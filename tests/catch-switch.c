@@ -0,0 +1,74 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "testing.h"
+
+#define PROTOCOL_ERRORS(ROOT, TYPE)                                         \
+  ROOT(PROTOCOL_ERROR, "Protocol error")                                    \
+  TYPE(BAD_FRAME, PROTOCOL_ERROR, "Bad frame")                              \
+  TYPE(BAD_CHECKSUM, BAD_FRAME, "Bad checksum")                             \
+  TYPE(TIMEOUT, PROTOCOL_ERROR, "Timeout")
+
+DECLARE_EXCEPTION_TYPES(PROTOCOL_ERRORS);
+DEFINE_EXCEPTION_TYPES(PROTOCOL_ERRORS);
+
+static const struct e4c_exception_type TRUNCATED_FRAME = {&BAD_FRAME, "Truncated frame"};
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+static int dispatch(const struct e4c_exception_type *);
+
+/**
+ * Tests macro CATCH_SWITCH.
+ */
+int main(void) {
+    volatile bool caught = false; /* NOSONAR */
+
+    TEST_ASSERT_INT_EQUALS(PROTOCOL_ERRORS_COUNT, 5);
+    TEST_ASSERT_INT_EQUALS(BAD_CHECKSUM.id, BAD_CHECKSUM_ID);
+
+    TEST_ASSERT_INT_EQUALS(dispatch(&BAD_FRAME), 1);
+    TEST_ASSERT_INT_EQUALS(dispatch(&BAD_CHECKSUM), 2);
+    TEST_ASSERT_INT_EQUALS(dispatch(&TRUNCATED_FRAME), 1);
+    TEST_ASSERT_INT_EQUALS(dispatch(&TIMEOUT), 3);
+
+    TRY {
+        dispatch(&OOPS);
+        TEST_FAIL("Reached %s:%d\n", __FILE__, __LINE__);
+    } CATCH (OOPS) {
+        caught = true;
+    }
+
+    TEST_ASSERT(caught);
+    TEST_PASS;
+}
+
+static int dispatch(const struct e4c_exception_type * type) {
+    volatile int result = 0; /* NOSONAR */
+    TRY {
+        THROW(*type, NULL);
+    } CATCH_SWITCH (PROTOCOL_ERRORS) {
+        CATCH_CASE (BAD_CHECKSUM)
+            result = 2;
+            break;
+        CATCH_CASE (BAD_FRAME)
+            result = 1;
+            break;
+        CATCH_DEFAULT
+            result = 3;
+    }
+    return result;
+}
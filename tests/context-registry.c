@@ -0,0 +1,92 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+#define THREADS 3
+
+static void * run_thread(void *);
+static pthread_barrier_t barrier;
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests that registered contexts are aggregated while their threads are running.
+ */
+int main(void) {
+    e4c_set_context_supplier(e4c_thread_context);
+    e4c_enable_context_registry();
+
+    struct e4c_statistics statistics = e4c_get_statistics();
+    TEST_ASSERT_INT_EQUALS(statistics.contexts, 1);
+    TEST_ASSERT_INT_EQUALS(statistics.blocks, 0);
+
+    TEST_ASSERT_INT_EQUALS(pthread_barrier_init(&barrier, NULL, THREADS + 1), 0);
+    pthread_t threads[THREADS];
+    for (int index = 0; index < THREADS; index++) {
+        TEST_ASSERT_INT_EQUALS(pthread_create(&threads[index], NULL, run_thread, NULL), 0);
+    }
+
+    /* every thread is catching an exception in a nested block */
+    (void) pthread_barrier_wait(&barrier);
+    statistics = e4c_get_statistics();
+    (void) pthread_barrier_wait(&barrier);
+    TEST_ASSERT_INT_EQUALS(statistics.contexts, THREADS + 1);
+    TEST_ASSERT_INT_EQUALS(statistics.blocks, THREADS * 2);
+    TEST_ASSERT_INT_EQUALS(statistics.max_depth, 2);
+    TEST_ASSERT_INT_EQUALS(statistics.exceptions, THREADS);
+
+    for (int index = 0; index < THREADS; index++) {
+        TEST_ASSERT_INT_EQUALS(pthread_join(threads[index], NULL), 0);
+    }
+
+    /* exiting threads unregister their contexts */
+    statistics = e4c_get_statistics();
+    TEST_ASSERT_INT_EQUALS(statistics.contexts, 1);
+    TEST_ASSERT_INT_EQUALS(statistics.blocks, 0);
+    TEST_ASSERT_INT_EQUALS(statistics.exceptions, 0);
+
+    /* the main thread gets registered on first use */
+    TRY {
+        statistics = e4c_get_statistics();
+    }
+    TEST_ASSERT_INT_EQUALS(statistics.contexts, 2);
+    TEST_ASSERT_INT_EQUALS(statistics.blocks, 1);
+
+    /* custom contexts can be registered too */
+    struct e4c_context custom = {0};
+    e4c_register_context(&custom);
+    e4c_register_context(&custom);
+    TEST_ASSERT_INT_EQUALS(e4c_get_statistics().contexts, 3);
+    e4c_unregister_context(&custom);
+    TEST_ASSERT_INT_EQUALS(e4c_get_statistics().contexts, 2);
+
+    TEST_PASS;
+}
+
+static void * run_thread(void * _) {
+    (void) _;
+    TRY {
+        TRY {
+            THROW(OOPS, NULL);
+        } CATCH (OOPS) {
+            (void) pthread_barrier_wait(&barrier);
+            (void) pthread_barrier_wait(&barrier);
+        }
+    }
+    return NULL;
+}
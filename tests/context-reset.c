@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "testing.h"
+
+static void handle_request(int);
+static void count_finalized(const struct e4c_exception *);
+static volatile int finalized = 0;
+static const struct e4c_exception_type CAUSE = {NULL, "Cause"};
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+static struct e4c_cancellation_token token;
+
+/**
+ * Tests that resetting a context deletes dangling blocks and leftover exceptions.
+ */
+int main(void) {
+    struct e4c_context * context = e4c_get_context();
+    struct e4c_reset_report report;
+
+    context->finalize_exception = count_finalized;
+    e4c_enable_context_registry();
+
+    /* a pristine context */
+    report = e4c_context_reset(context);
+    TEST_ASSERT_INT_EQUALS(report.blocks, 0);
+    TEST_ASSERT_INT_EQUALS(report.exceptions, 0);
+
+    /* a request that returns from a TRY block */
+    handle_request(1);
+    TEST_ASSERT_NOT_NULL(context->_innermost_block);
+    report = e4c_context_reset(context);
+    TEST_ASSERT_INT_EQUALS(report.blocks, 1);
+    TEST_ASSERT_INT_EQUALS(report.exceptions, 0);
+    TEST_ASSERT_NULL(context->_innermost_block);
+
+    /* a request that returns from nested CATCH blocks */
+    handle_request(2);
+    TEST_ASSERT_INT_EQUALS(e4c_get_statistics().blocks, 2);
+    TEST_ASSERT_INT_EQUALS(e4c_get_statistics().exceptions, 2);
+    report = e4c_context_reset(context);
+    TEST_ASSERT_INT_EQUALS(report.blocks, 2);
+    TEST_ASSERT_INT_EQUALS(report.exceptions, 2);
+    TEST_ASSERT_INT_EQUALS(finalized, 2);
+    TEST_ASSERT_INT_EQUALS(e4c_get_statistics().blocks, 0);
+    TEST_ASSERT_INT_EQUALS(e4c_get_statistics().exceptions, 0);
+
+    /* the cancellation token is detached */
+    (void) e4c_set_cancellation_token(context, &token);
+    report = e4c_context_reset(context);
+    TEST_ASSERT_NULL(e4c_get_cancellation_token(context));
+
+    /* the handlers are preserved, and the context can be used again */
+    TEST_ASSERT(context->finalize_exception == count_finalized);
+    handle_request(0);
+    report = e4c_context_reset(context);
+    TEST_ASSERT_INT_EQUALS(report.blocks, 0);
+    TEST_ASSERT_INT_EQUALS(finalized, 4);
+    TEST_PASS;
+}
+
+static void handle_request(const int dangling) {
+    TRY {
+        if (dangling == 1) {
+            return;
+        }
+        TRY {
+            TRY {
+                THROW(CAUSE, NULL);
+            } CATCH (CAUSE) {
+                THROW(OOPS, NULL);
+            }
+        } CATCH (OOPS) {
+            if (dangling == 2) {
+                return;
+            }
+        }
+    }
+}
+
+static void count_finalized(const struct e4c_exception * _) {
+    (void) _;
+    finalized++;
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Custom non-local jump backend, used to run the test suite via `make check-backends`.
+ */
+
+#include <setjmp.h>
+
+#define EXCEPTIONS4C_ENV jmp_buf
+
+#define EXCEPTIONS4C_SET_JUMP(env, save_signal_mask) setjmp(*(env))
+
+#define EXCEPTIONS4C_LONG_JUMP(env) longjmp(*(env), 1)
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <exceptions4c-ipc.h>
+#include "testing.h"
+
+static void run_worker(void);
+static const struct e4c_exception_type * resolve(const char *);
+static const struct e4c_exception_type CAUSE = {NULL, "Cause"};
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests that an uncaught exception in a worker process can be thrown again in the supervisor.
+ */
+int main(void) {
+    volatile bool caught = false; /* NOSONAR */
+    struct e4c_ring * volatile ring = e4c_ring_create(2);
+    pid_t writer = 0;
+
+    TEST_ASSERT_NULL(e4c_ring_read(ring, NULL, resolve));
+
+    const pid_t worker = fork();
+    if (worker == 0) {
+        e4c_ring_install(ring);
+        run_worker();
+        _exit(EXIT_SUCCESS);
+    }
+    int status;
+    TEST_ASSERT_INT_EQUALS(waitpid(worker, &status, 0), worker);
+    TEST_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_FAILURE);
+
+    struct e4c_exception * exception = e4c_ring_read(ring, &writer, resolve);
+    TEST_ASSERT_NOT_NULL(exception);
+    TEST_ASSERT_INT_EQUALS(writer, worker);
+    TEST_ASSERT_NULL(e4c_ring_read(ring, NULL, resolve));
+
+    TRY {
+        THROW_CAPTURED(exception);
+    } CATCH (OOPS) {
+        caught = true;
+        const struct e4c_exception * thrown = e4c_get_exception();
+        TEST_ASSERT_STR_EQUALS(thrown->name, "OOPS");
+        TEST_ASSERT_STR_EQUALS(thrown->message, "Worker 42 failed");
+        TEST_ASSERT_STR_EQUALS(thrown->file, __FILE__);
+        TEST_ASSERT_STR_EQUALS(thrown->function, "run_worker");
+        TEST_ASSERT_NOT_NULL(thrown->cause);
+        TEST_ASSERT_PTR_EQUALS(thrown->cause->type, &REMOTE_ERROR);
+        TEST_ASSERT_STR_EQUALS(thrown->cause->name, "CAUSE");
+        TEST_ASSERT_STR_EQUALS(thrown->cause->message, "Cause");
+        TEST_ASSERT_NULL(thrown->cause->cause);
+
+        /* the ring drops records when full */
+        TEST_ASSERT(e4c_ring_write(ring, thrown));
+        TEST_ASSERT(e4c_ring_write(ring, thrown));
+        TEST_ASSERT(!e4c_ring_write(ring, thrown));
+    }
+
+    TEST_ASSERT(caught);
+    for (int index = 0; index < 2; index++) {
+        exception = e4c_ring_read(ring, &writer, NULL);
+        TEST_ASSERT_NOT_NULL(exception);
+        TEST_ASSERT_INT_EQUALS(writer, getpid());
+        TEST_ASSERT_PTR_EQUALS(exception->type, &REMOTE_ERROR);
+        free(exception);
+    }
+    TEST_ASSERT_NULL(e4c_ring_read(ring, NULL, NULL));
+    e4c_ring_delete(ring);
+    TEST_PASS;
+}
+
+static void run_worker(void) {
+    TRY {
+        THROW(CAUSE, NULL);
+    } CATCH (CAUSE) {
+        THROW(OOPS, "Worker %d failed", 42);
+    }
+}
+
+static const struct e4c_exception_type * resolve(const char * name) {
+    return strcmp(name, "OOPS") == 0 ? &OOPS : NULL;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ucontext.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+#define STACK_SIZE 65536
+
+struct fiber {
+    ucontext_t ucontext;
+    struct e4c_context context;
+    char stack[STACK_SIZE];
+    volatile bool caught;
+    volatile bool finalized;
+    volatile bool done;
+};
+
+static void run_fiber_a(void);
+static void run_fiber_b(void);
+static void yield(void);
+static void resume(struct fiber *);
+static struct fiber fiber_a, fiber_b;
+static struct fiber * current = NULL;
+static ucontext_t scheduler;
+static const struct e4c_exception_type OOPS_A = {NULL, "Oops A"};
+static const struct e4c_exception_type OOPS_B = {NULL, "Oops B"};
+
+/**
+ * Tests that fibers can yield in the middle of exception blocks when each one has its own context.
+ */
+int main(void) {
+    volatile bool caught = false; /* NOSONAR */
+    struct e4c_context * main_context = e4c_get_context();
+
+    getcontext(&fiber_a.ucontext);
+    fiber_a.ucontext.uc_stack.ss_sp = fiber_a.stack;
+    fiber_a.ucontext.uc_stack.ss_size = STACK_SIZE;
+    fiber_a.ucontext.uc_link = &scheduler;
+    makecontext(&fiber_a.ucontext, run_fiber_a, 0);
+    getcontext(&fiber_b.ucontext);
+    fiber_b.ucontext.uc_stack.ss_sp = fiber_b.stack;
+    fiber_b.ucontext.uc_stack.ss_size = STACK_SIZE;
+    fiber_b.ucontext.uc_link = &scheduler;
+    makecontext(&fiber_b.ucontext, run_fiber_b, 0);
+
+    TRY {
+        /* interleave both fibers until they finish */
+        for (int step = 0; step < 4; step++) {
+            resume(&fiber_a);
+            resume(&fiber_b);
+        }
+        TEST_ASSERT_PTR_EQUALS(e4c_get_context(), main_context);
+        TEST_ASSERT_NULL(e4c_get_exception());
+        THROW(OOPS_A, "Main");
+    } CATCH (OOPS_A) {
+        caught = true;
+        TEST_ASSERT_STR_EQUALS(e4c_get_exception()->message, "Main");
+    }
+
+    TEST_ASSERT(caught);
+    TEST_ASSERT(fiber_a.done);
+    TEST_ASSERT(fiber_b.done);
+    TEST_ASSERT(fiber_a.caught);
+    TEST_ASSERT(fiber_a.finalized);
+    TEST_ASSERT(fiber_b.caught);
+    TEST_ASSERT(fiber_b.finalized);
+    TEST_ASSERT_NULL(fiber_a.context._innermost_block);
+    TEST_ASSERT_NULL(fiber_b.context._innermost_block);
+    TEST_ASSERT_NULL(e4c_switch_context(NULL));
+    TEST_PASS;
+}
+
+static void run_fiber_a(void) {
+    TRY {
+        yield();
+        THROW(OOPS_A, "Fiber A");
+    } CATCH (OOPS_A) {
+        yield();
+        fiber_a.caught = e4c_get_exception()->type == &OOPS_A;
+    } FINALLY {
+        yield();
+        fiber_a.finalized = true;
+    }
+    fiber_a.done = true;
+}
+
+static void run_fiber_b(void) {
+    TRY {
+        THROW(OOPS_B, "Fiber B");
+    } CATCH (OOPS_B) {
+        yield();
+        TRY {
+            yield();
+        } FINALLY {
+            TEST_ASSERT_NULL(e4c_get_exception());
+        }
+        fiber_b.caught = e4c_get_exception()->type == &OOPS_B;
+    } FINALLY {
+        fiber_b.finalized = true;
+    }
+    fiber_b.done = true;
+}
+
+static void yield(void) {
+    swapcontext(&current->ucontext, &scheduler);
+}
+
+static void resume(struct fiber * fiber) {
+    if (fiber->done) {
+        return;
+    }
+    struct e4c_context * previous = e4c_switch_context(&fiber->context);
+    current = fiber;
+    swapcontext(&scheduler, &fiber->ucontext);
+    current = NULL;
+    (void) e4c_switch_context(previous);
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <exceptions4c-parallel.h>
+#include "testing.h"
+
+static void succeed(void *);
+static void fail(void *);
+static void wait_for_cancellation(void *);
+static void checkpoint_until_cancelled(void *);
+static void fail_together(void *);
+static void count_finalized(const struct e4c_exception *);
+static pthread_barrier_t barrier;
+static atomic_int finalized_exceptions = 0;
+static atomic_int completed = 0;
+static atomic_int waiting = 0;
+static atomic_int cancelled = 0;
+static atomic_int checkpointed = 0;
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests that nursery blocks wait for their tasks and throw the first failure.
+ */
+int main(void) {
+    volatile bool caught = false, finalized = false; /* NOSONAR */
+
+    /* the default context supplier is enough, since every thread attaches its own context */
+
+    /* every task succeeds */
+    NURSERY {
+        SPAWN(succeed, NULL);
+        SPAWN(succeed, NULL);
+        SPAWN(succeed, NULL);
+    } FINALLY {
+        finalized = true;
+    }
+    TEST_ASSERT(finalized);
+    TEST_ASSERT_INT_EQUALS(atomic_load(&completed), 3);
+
+    /* one task fails and its siblings are cancelled */
+    finalized = false;
+    NURSERY {
+        SPAWN(wait_for_cancellation, NULL);
+        SPAWN(wait_for_cancellation, NULL);
+        SPAWN(fail, "first");
+    } CATCH (OOPS) {
+        caught = true;
+        TEST_ASSERT_STR_EQUALS(e4c_get_exception()->message, "first");
+    } FINALLY {
+        finalized = true;
+    }
+    TEST_ASSERT(caught);
+    TEST_ASSERT(finalized);
+    TEST_ASSERT_INT_EQUALS(atomic_load(&cancelled), 2);
+
+    /* siblings that reach a checkpoint are cancelled too */
+    caught = false;
+    atomic_store(&waiting, 0);
+    NURSERY {
+        SPAWN(checkpoint_until_cancelled, NULL);
+        SPAWN(checkpoint_until_cancelled, NULL);
+        SPAWN(fail, "checkpoint");
+    } CATCH (OOPS) {
+        caught = true;
+        TEST_ASSERT_STR_EQUALS(e4c_get_exception()->message, "checkpoint");
+    }
+    TEST_ASSERT(caught);
+    TEST_ASSERT_INT_EQUALS(atomic_load(&checkpointed), 2);
+
+    /* the nursery block fails: its tasks are cancelled and their exceptions suppressed */
+    caught = false;
+    TRY {
+        NURSERY {
+            SPAWN(wait_for_cancellation, NULL);
+            SPAWN(fail, "suppressed");
+            THROW(OOPS, "parent");
+        }
+    } CATCH (OOPS) {
+        caught = true;
+        TEST_ASSERT_STR_EQUALS(e4c_get_exception()->message, "parent");
+    }
+    TEST_ASSERT(caught);
+
+    /* suppressed exceptions are finalized before they are deleted */
+    caught = false;
+    e4c_get_context()->finalize_exception = count_finalized;
+    TEST_ASSERT_INT_EQUALS(pthread_barrier_init(&barrier, NULL, 2), 0);
+    NURSERY {
+        SPAWN(fail_together, "together");
+        SPAWN(fail_together, "together");
+    } CATCH (OOPS) {
+        caught = true;
+    }
+    TEST_ASSERT(caught);
+    /* both tasks deleted their exceptions; then the suppressed one and the thrown one were deleted */
+    TEST_ASSERT_INT_EQUALS(atomic_load(&finalized_exceptions), 4);
+    TEST_ASSERT_INT_EQUALS(pthread_barrier_destroy(&barrier), 0);
+    e4c_get_context()->finalize_exception = NULL;
+
+    TEST_ASSERT(!e4c_is_cancelled());
+    TEST_PASS;
+}
+
+static void succeed(void * _) {
+    (void) _;
+    atomic_fetch_add(&completed, 1);
+}
+
+static void fail(void * message) {
+    /* let the siblings start before failing */
+    while (!e4c_is_cancelled() && atomic_load(&waiting) < 2) {
+        (void) usleep(1000);
+    }
+    THROW(OOPS, "%s", (const char *) message);
+}
+
+static void wait_for_cancellation(void * _) {
+    (void) _;
+    atomic_fetch_add(&waiting, 1);
+    while (!e4c_is_cancelled()) {
+        (void) usleep(1000);
+    }
+    atomic_fetch_add(&cancelled, 1);
+}
+
+static void checkpoint_until_cancelled(void * _) {
+    (void) _;
+    atomic_fetch_add(&waiting, 1);
+    TRY {
+        for (;;) {
+            CHECKPOINT();
+            (void) usleep(1000);
+        }
+    } CATCH (CANCELLED) {
+        TEST_ASSERT_STR_EQUALS(e4c_get_exception()->message, "A sibling task failed");
+        atomic_fetch_add(&checkpointed, 1);
+    }
+}
+
+static void fail_together(void * message) {
+    /* both tasks have started before either of them fails */
+    (void) pthread_barrier_wait(&barrier);
+    THROW(OOPS, "%s", (const char *) message);
+}
+
+static void count_finalized(const struct e4c_exception * exception) {
+    if (exception->type == &OOPS && strcmp(exception->message, "together") == 0) {
+        atomic_fetch_add(&finalized_exceptions, 1);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "testing.h"
+
+static void complete(struct e4c_operation *, int);
+static void count_finalized(const struct e4c_exception *);
+static volatile int finalized = 0;
+static const struct e4c_exception_type CAUSE = {NULL, "Cause"};
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests that the exception an asynchronous operation failed with is thrown by its continuation.
+ */
+int main(void) {
+    volatile bool caught = false; /* NOSONAR */
+    struct e4c_operation operation = {0};
+
+    e4c_get_context()->finalize_exception = count_finalized;
+
+    /* successful operations don't throw anything */
+    complete(&operation, 0);
+    TEST_ASSERT_NULL(operation._failure);
+    TRY {
+        THROW_IF_FAILED(&operation);
+    } CATCH_ALL {
+        TEST_FAIL("Successful operation should not have thrown an exception\n");
+    }
+
+    /* failed operations keep their first failure only */
+    complete(&operation, 1);
+    complete(&operation, 2);
+    TEST_ASSERT_NOT_NULL(operation._failure);
+    TEST_ASSERT_INT_EQUALS(finalized, 4);
+
+    TRY {
+        THROW_IF_FAILED(&operation);
+        TEST_FAIL("Failed operation should have thrown an exception\n");
+    } CATCH (OOPS) {
+        caught = true;
+        const struct e4c_exception * exception = e4c_get_exception();
+        TEST_ASSERT_STR_EQUALS(exception->message, "Operation 1 failed");
+        TEST_ASSERT_NOT_NULL(exception->cause);
+        TEST_ASSERT_PTR_EQUALS(exception->cause->type, &CAUSE);
+        TEST_ASSERT_NULL(operation._failure);
+    }
+
+    TEST_ASSERT(caught);
+    TEST_ASSERT_INT_EQUALS(finalized, 6);
+    TEST_ASSERT_NULL(e4c_operation_take(&operation));
+    TEST_PASS;
+}
+
+static void complete(struct e4c_operation * operation, const int id) {
+    TRY {
+        if (id > 0) {
+            TRY {
+                THROW(CAUSE, NULL);
+            } CATCH (CAUSE) {
+                THROW(OOPS, "Operation %d failed", id);
+            }
+        }
+    } CATCH_ALL {
+        TEST_ASSERT(e4c_operation_fail(operation) == (id == 1));
+    }
+}
+
+static void count_finalized(const struct e4c_exception * _) {
+    (void) _;
+    finalized++;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <stdatomic.h>
+#include <exceptions4c-parallel.h>
+#include "testing.h"
+
+#define COUNT 1000
+
+static void validate(int, void *);
+static void validate_slowly(int, void *);
+static void fail(int, void *);
+static atomic_int visits[COUNT];
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests that exceptions thrown in parallel loops are collected and thrown in the calling thread.
+ */
+int main(void) {
+    volatile bool caught = false; /* NOSONAR */
+
+    /* the default context supplier is enough, since every thread attaches its own context */
+
+    TRY {
+        e4c_parallel_for(COUNT, validate, NULL, 4, false);
+    } CATCH (PARALLEL_ERROR) {
+        caught = true;
+        const struct e4c_exception * exception = e4c_get_exception();
+        TEST_ASSERT_STR_EQUALS(exception->message, "3 of 1000 failed: [10] OOPS: Index 10; [500] OOPS: Index 500; [999] OOPS: Index 999;");
+        TEST_ASSERT_NOT_NULL(exception->cause);
+        TEST_ASSERT_PTR_EQUALS(exception->cause->type, &OOPS);
+        TEST_ASSERT_STR_EQUALS(exception->cause->message, "Index 10");
+        TEST_ASSERT_STR_EQUALS(e4c_parallel_failure(exception, 500)->message, "Index 500");
+        TEST_ASSERT_STR_EQUALS(e4c_parallel_failure(exception, 999)->message, "Index 999");
+        TEST_ASSERT_NULL(e4c_parallel_failure(exception, 11));
+        TEST_ASSERT_NULL(e4c_parallel_failure(exception->cause, 10));
+    }
+    TEST_ASSERT(caught);
+
+    /* every failure can be retrieved, even if the message cannot list all of them */
+    caught = false;
+    TRY {
+        e4c_parallel_for(COUNT, fail, NULL, 4, false);
+    } CATCH (PARALLEL_ERROR) {
+        caught = true;
+        const struct e4c_exception * exception = e4c_get_exception();
+        TEST_ASSERT_STR_CONTAINS(exception->message, "1000 of 1000 failed: [0] OOPS: Index 0;");
+        TEST_ASSERT_STR_CONTAINS(exception->message, "...");
+        for (int index = 0; index < COUNT; index++) {
+            const struct e4c_exception * failure = e4c_parallel_failure(exception, index);
+            TEST_ASSERT_NOT_NULL(failure);
+            TEST_ASSERT_PTR_EQUALS(failure->type, &OOPS);
+        }
+    }
+    TEST_ASSERT(caught);
+    for (int index = 0; index < COUNT; index++) {
+        TEST_ASSERT_INT_EQUALS(atomic_load(&visits[index]), 1);
+    }
+
+    /* the remaining indices are skipped after the first failure */
+    caught = false;
+    TRY {
+        e4c_parallel_for(COUNT, validate_slowly, NULL, 4, true);
+    } CATCH (PARALLEL_ERROR) {
+        caught = true;
+        TEST_ASSERT_STR_EQUALS(e4c_get_exception()->message, "1 of 1000 failed: [0] OOPS: Index 0;");
+    }
+    TEST_ASSERT(caught);
+    int visited = 0;
+    for (int index = 0; index < COUNT; index++) {
+        visited += atomic_load(&visits[index]) > 1;
+    }
+    TEST_ASSERT(visited < COUNT);
+
+    /* nothing to run */
+    e4c_parallel_for(0, validate, NULL, 4, false);
+
+    TEST_PASS;
+}
+
+static void validate(const int index, void * _) {
+    (void) _;
+    atomic_fetch_add(&visits[index], 1);
+    if (index == 10 || index == 500 || index == 999) {
+        THROW(OOPS, "Index %d", index);
+    }
+}
+
+static void validate_slowly(const int index, void * _) {
+    (void) _;
+    atomic_fetch_add(&visits[index], 1);
+    if (index == 0) {
+        THROW(OOPS, "Index %d", index);
+    }
+    (void) usleep(100);
+}
+
+static void fail(const int index, void * _) {
+    (void) _;
+    THROW(OOPS, "Index %d", index);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+static volatile char sink;
+
+static size_t read_all(const char *, size_t);
+
+/**
+ * Tests that accessing a truncated memory-mapped file throws MAPPED_IO_ERROR.
+ */
+int main(void) {
+    const size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    const size_t size = 3 * page;
+    FILE * file = tmpfile();
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_INT_EQUALS(ftruncate(fileno(file), (off_t) size), 0);
+    const char * mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fileno(file), 0);
+    TEST_ASSERT(mapping != MAP_FAILED);
+
+    /* no fault */
+    TEST_ASSERT(read_all(mapping, size) == size);
+
+    /* truncate the file underneath the mapping */
+    TEST_ASSERT_INT_EQUALS(ftruncate(fileno(file), (off_t) page), 0);
+    for (int attempt = 0; attempt < 3; attempt++) {
+        volatile bool caught = false;
+        TRY {
+            (void) read_all(mapping, size);
+        } CATCH (MAPPED_IO_ERROR) {
+            const struct e4c_signal_info * info = e4c_get_signal_info(e4c_get_exception());
+            TEST_ASSERT_NOT_NULL(info);
+            TEST_ASSERT_INT_EQUALS(info->signal_number, SIGBUS);
+            TEST_ASSERT(info->offset == page);
+            TEST_ASSERT(info->address == mapping + page);
+            caught = true;
+        }
+        TEST_ASSERT(caught);
+    }
+
+    /* the fault is handled by the probe whose region contains the faulting address */
+    volatile bool caught = false;
+    TRY {
+        PROBE (mapping, size) {
+            PROBE (mapping, page) {
+                TRY {
+                    sink = mapping[2 * page];
+                } FINALLY {
+                    TEST_FAIL("Blocks started inside the probed region should be discarded\n");
+                }
+            }
+        }
+    } CATCH (MAPPED_IO_ERROR) {
+        TEST_ASSERT(e4c_get_signal_info(e4c_get_exception())->offset == 2 * page);
+        caught = true;
+    }
+    TEST_ASSERT(caught);
+
+    /* nothing is left dangling */
+    const struct e4c_reset_report report = e4c_context_reset(e4c_get_context());
+    TEST_ASSERT_INT_EQUALS(report.blocks, 0);
+    TEST_ASSERT_INT_EQUALS(report.exceptions, 0);
+
+    TEST_ASSERT_INT_EQUALS(munmap((void *) mapping, size), 0);
+    (void) fclose(file);
+    TEST_PASS;
+}
+
+static size_t read_all(const char * mapping, const size_t size) {
+    size_t bytes = 0;
+    PROBE (mapping, size) {
+        for (size_t index = 0; index < size; index++) {
+            sink = mapping[index];
+            bytes++;
+        }
+    }
+    return bytes;
+}
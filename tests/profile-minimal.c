@@ -0,0 +1,53 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "testing.h"
+
+static const struct e4c_exception_type CAUSE = {NULL, "Cause"};
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests that the core functionality works when every optional feature is compiled out.
+ */
+int main(void) {
+    volatile bool caught = false, finalized = false; /* NOSONAR */
+
+#if defined(RETRY) || defined(REACQUIRE)
+    TEST_FAIL("%s:%d [ERROR] RETRY and REACQUIRE should be compiled out\n", __FILE__, __LINE__);
+#endif
+
+    TEST_ASSERT_INT_EQUALS((int) sizeof(struct e4c_context), (int) sizeof(void *));
+
+    TRY {
+        TRY {
+            THROW(CAUSE, NULL);
+        } CATCH (CAUSE) {
+            THROW(OOPS, "Oops %d", 123);
+        }
+    } CATCH (OOPS) {
+        caught = true;
+        TEST_ASSERT_STR_EQUALS(e4c_get_exception()->message, "Oops 123");
+        TEST_ASSERT_NOT_NULL(e4c_get_exception()->cause);
+        TEST_ASSERT_PTR_EQUALS(e4c_get_exception()->cause->type, &CAUSE);
+    } FINALLY {
+        finalized = true;
+    }
+
+    TEST_ASSERT(caught);
+    TEST_ASSERT(finalized);
+    TEST_PASS;
+}
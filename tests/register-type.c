@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "testing.h"
+
+static struct e4c_type_display error_display;
+static struct e4c_type_display io_error_display;
+static struct e4c_type_display file_error_display;
+
+static const struct e4c_exception_type ERROR = {NULL, "Error", &error_display};
+static const struct e4c_exception_type IO_ERROR = {&ERROR, "I/O error", &io_error_display};
+static const struct e4c_exception_type FILE_ERROR = {&IO_ERROR, "File error", &file_error_display};
+static const struct e4c_exception_type OTHER_ERROR = {&ERROR, "Other error"};
+
+static struct e4c_exception_type LOOP_1 = {NULL, "Loop 1"};
+static struct e4c_exception_type LOOP_2 = {&LOOP_1, "Loop 2"};
+static struct e4c_exception_type LOOP_3 = {&LOOP_2, "Loop 3"};
+
+/**
+ * Tests that exception types can be registered.
+ */
+int main(void) {
+    volatile bool caught = false; /* NOSONAR */
+
+    TEST_ASSERT_TRUE(e4c_register_type(&FILE_ERROR));
+    TEST_ASSERT_TRUE(e4c_register_type(&OTHER_ERROR));
+
+    TEST_ASSERT_INT_EQUALS(error_display.depth, 0);
+    TEST_ASSERT_INT_EQUALS(io_error_display.depth, 1);
+    TEST_ASSERT_INT_EQUALS(file_error_display.depth, 2);
+    TEST_ASSERT_PTR_EQUALS(file_error_display.ancestors[0], &ERROR);
+    TEST_ASSERT_PTR_EQUALS(file_error_display.ancestors[1], &IO_ERROR);
+    TEST_ASSERT_PTR_EQUALS(file_error_display.ancestors[2], &FILE_ERROR);
+
+    TRY {
+        THROW(IO_ERROR, NULL);
+    } CATCH (FILE_ERROR) {
+        TEST_FAIL("Subtype caught a supertype %s:%d\n", __FILE__, __LINE__);
+    } CATCH (OTHER_ERROR) {
+        TEST_FAIL("Sibling caught an unrelated type %s:%d\n", __FILE__, __LINE__);
+    } CATCH (ERROR) {
+        caught = true;
+    }
+    TEST_ASSERT(caught);
+
+    /* registered types are matched in constant time by CATCH_ANY too */
+    caught = false;
+    TRY {
+        THROW(FILE_ERROR, NULL);
+    } CATCH_ANY (OTHER_ERROR, ERROR) {
+        caught = true;
+    }
+    TEST_ASSERT(caught);
+
+    /* a cycle can be detected, even if it does not include the registered type */
+    LOOP_1.supertype = &LOOP_2;
+    TEST_ASSERT_FALSE(e4c_register_type(&LOOP_3));
+    LOOP_1.supertype = &LOOP_1;
+    TEST_ASSERT_FALSE(e4c_register_type(&LOOP_1));
+
+    TEST_PASS;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exceptions4c.h>
+#include "testing.h"
+
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+static const struct e4c_exception_type GIVE_UP = {NULL, "Giving up"};
+
+static long long now = 0;
+static int delays[10];
+static volatile int total_delays = 0;
+
+static long long fake_clock(void);
+static void fake_sleep(long);
+
+/**
+ * Tests macros RETRY_BACKOFF and REACQUIRE_BACKOFF.
+ */
+int main(void) {
+
+    volatile int total_attempts = 0; /* NOSONAR */
+    volatile bool gave_up = false;
+
+    /* exponential delays are capped */
+    static const struct e4c_backoff exponential = {
+        .strategy = E4C_BACKOFF_EXPONENTIAL, .initial_delay = 10, .max_delay = 50, .clock = fake_clock, .sleep = fake_sleep
+    };
+    TRY {
+        TRY {
+            total_attempts++;
+            THROW(OOPS, NULL);
+        } CATCH (OOPS) {
+            RETRY_BACKOFF(5, exponential, GIVE_UP, NULL);
+        }
+    } CATCH (GIVE_UP) {
+        gave_up = true;
+    }
+    TEST_ASSERT(gave_up);
+    TEST_ASSERT_INT_EQUALS(total_attempts, 6);
+    TEST_ASSERT_INT_EQUALS(total_delays, 5);
+    TEST_ASSERT_INT_EQUALS(delays[0], 10);
+    TEST_ASSERT_INT_EQUALS(delays[1], 20);
+    TEST_ASSERT_INT_EQUALS(delays[2], 40);
+    TEST_ASSERT_INT_EQUALS(delays[3], 50);
+    TEST_ASSERT_INT_EQUALS(delays[4], 50);
+
+    /* jittered delays stay between the initial delay and three times the previous one */
+    static const struct e4c_backoff jitter = {
+        .strategy = E4C_BACKOFF_DECORRELATED_JITTER, .initial_delay = 10, .max_delay = 1000, .clock = fake_clock, .sleep = fake_sleep
+    };
+    total_attempts = 0;
+    total_delays = 0;
+    TRY {
+        total_attempts++;
+        THROW(OOPS, NULL);
+    } CATCH (OOPS) {
+        if (total_attempts < 9) {
+            RETRY_BACKOFF(10, jitter, GIVE_UP, NULL);
+        }
+    }
+    TEST_ASSERT_INT_EQUALS(total_delays, 8);
+    for (int index = 0; index < total_delays; index++) {
+        const long previous = index > 0 ? delays[index - 1] : jitter.initial_delay;
+        TEST_PRINT_OUT("delay %d: %d\n", index, delays[index]);
+        TEST_ASSERT(delays[index] >= jitter.initial_delay);
+        TEST_ASSERT(delays[index] <= previous * 3);
+        TEST_ASSERT(delays[index] <= jitter.max_delay);
+    }
+
+    /* no more attempts are made when waiting would exceed the time budget */
+    static const struct e4c_backoff budget = {
+        .strategy = E4C_BACKOFF_EXPONENTIAL, .initial_delay = 100, .budget = 250, .clock = fake_clock, .sleep = fake_sleep
+    };
+    total_attempts = 0;
+    total_delays = 0;
+    gave_up = false;
+    TRY {
+        TRY {
+            total_attempts++;
+            THROW(OOPS, NULL);
+        } CATCH (OOPS) {
+            RETRY_BACKOFF(10, budget, GIVE_UP, "Out of time");
+        }
+    } CATCH (GIVE_UP) {
+        gave_up = true;
+        TEST_ASSERT(e4c_get_exception()->cause != NULL);
+    }
+    TEST_ASSERT(gave_up);
+    TEST_ASSERT_INT_EQUALS(total_attempts, 2);
+    TEST_ASSERT_INT_EQUALS(total_delays, 1);
+    TEST_ASSERT_INT_EQUALS(delays[0], 100);
+
+    /* resources are reacquired with the same policies */
+    total_attempts = 0;
+    total_delays = 0;
+    gave_up = false;
+    TRY {
+        WITH(0) {
+            total_attempts++;
+            THROW(OOPS, NULL);
+        } USE (true) {
+            TEST_FAIL("Resource acquired unexpectedly\n");
+        } CATCH (OOPS) {
+            REACQUIRE_BACKOFF(2, exponential, GIVE_UP, NULL);
+        }
+    } CATCH (GIVE_UP) {
+        gave_up = true;
+    }
+    TEST_ASSERT(gave_up);
+    TEST_ASSERT_INT_EQUALS(total_attempts, 3);
+    TEST_ASSERT_INT_EQUALS(total_delays, 2);
+    TEST_ASSERT_INT_EQUALS(delays[0], 10);
+    TEST_ASSERT_INT_EQUALS(delays[1], 20);
+
+    TEST_PASS;
+}
+
+/**
+ * Returns the current time of the fake clock.
+ *
+ * @return the current time, in milliseconds.
+ */
+static long long fake_clock(void) {
+    return now;
+}
+
+/**
+ * Records a delay and advances the fake clock.
+ *
+ * @param milliseconds the number of milliseconds to fake_sleep.
+ */
+static void fake_sleep(long milliseconds) {
+    delays[total_delays] = (int) milliseconds;
+    total_delays = total_delays + 1;
+    now += milliseconds;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+#define THREADS 4
+#define FAULTS 100
+
+static void * run_faulting_thread(void *);
+static const struct e4c_exception_type INTERRUPTED = {NULL, "Interrupted"};
+
+/**
+ * Tests that mapped signals are thrown to the faulting thread, along with the signal information.
+ */
+int main(void) {
+    static const struct e4c_signal_mapping mappings[] = {
+        SIGNAL_MAPPING(SIGUSR1, INTERRUPTED)
+    };
+    pthread_t threads[THREADS];
+    void * faults[THREADS];
+    int status;
+
+#if EXCEPTIONS4C_BACKEND != EXCEPTIONS4C_BACKEND_SIGSETJMP && EXCEPTIONS4C_BACKEND != EXCEPTIONS4C_BACKEND_UCONTEXT
+    TEST_SKIP("the signal mask cannot be saved by this backend");
+#endif
+
+    e4c_set_context_supplier(e4c_thread_context);
+    TEST_ASSERT(e4c_map_signals(NULL, 0));
+    TEST_ASSERT(e4c_map_signals(mappings, 1));
+
+    /* each thread catches its own faults */
+    for (intptr_t index = 0; index < THREADS; index++) {
+        TEST_ASSERT_INT_EQUALS(pthread_create(&threads[index], NULL, run_faulting_thread, (void *) index), 0);
+    }
+    for (int index = 0; index < THREADS; index++) {
+        TEST_ASSERT_INT_EQUALS(pthread_join(threads[index], &faults[index]), 0);
+        TEST_ASSERT_INT_EQUALS((int) (intptr_t) faults[index], FAULTS);
+    }
+
+    /* custom mappings */
+    volatile bool caught = false;
+    TRY_SIGNALSAFE {
+        (void) raise(SIGUSR1);
+    } CATCH (INTERRUPTED) {
+        const struct e4c_signal_info * info = e4c_get_signal_info(e4c_get_exception());
+        TEST_ASSERT_NOT_NULL(info);
+        TEST_ASSERT_INT_EQUALS(info->signal_number, SIGUSR1);
+        TEST_ASSERT_STR_EQUALS(e4c_get_exception()->name, "INTERRUPTED");
+        caught = true;
+    }
+    TEST_ASSERT(caught);
+
+    /* regular exceptions carry no signal information */
+    caught = false;
+    TRY {
+        THROW(INTERRUPTED, NULL);
+    } CATCH (INTERRUPTED) {
+        TEST_ASSERT_NULL(e4c_get_signal_info(e4c_get_exception()));
+        caught = true;
+    }
+    TEST_ASSERT(caught);
+
+    /* signals received outside exception blocks still crash the program */
+    const pid_t child = fork();
+    if (child == 0) {
+        volatile int * volatile null_pointer = NULL;
+        *null_pointer = 0;
+        _exit(EXIT_SUCCESS);
+    }
+    TEST_ASSERT_INT_EQUALS(waitpid(child, &status, 0), child);
+    TEST_ASSERT(WIFSIGNALED(status));
+    TEST_ASSERT_INT_EQUALS(WTERMSIG(status), SIGSEGV);
+
+    TEST_PASS;
+}
+
+static void * run_faulting_thread(void * argument) {
+    /* a distinct address per thread, all of them within the first page */
+    volatile int * const address = (volatile int *) (sizeof(int) * (1 + (uintptr_t) argument));
+    intptr_t faults = 0;
+    for (int attempt = 0; attempt < FAULTS; attempt++) {
+        TRY_SIGNALSAFE {
+            *address = attempt;
+        } CATCH (SIGNAL_ERROR) {
+            const struct e4c_exception * exception = e4c_get_exception();
+            const struct e4c_signal_info * info = e4c_get_signal_info(exception);
+            if (exception->type != &SEGMENTATION_FAULT || info == NULL
+                || info->signal_number != SIGSEGV || info->code != SEGV_MAPERR || info->address != (void *) address) {
+                TEST_FAIL("Unexpected signal information\n");
+            }
+            faults++;
+        }
+    }
+    return (void *) faults;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ucontext.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+#define STACK_SIZE (256 * 1024)
+
+static void run_fiber(void);
+static ucontext_t scheduler;
+static ucontext_t fiber;
+static volatile bool ran = false;
+
+/**
+ * Tests that exception blocks started by fibers, on stacks of their own, are not mistaken for stack overflows.
+ */
+int main(void) {
+    volatile bool overflowed = false; /* NOSONAR */
+
+    if (!e4c_handle_stack_overflow()) {
+        TEST_SKIP("stack overflows cannot be detected in this platform");
+    }
+
+    void * stack = malloc(STACK_SIZE);
+    TEST_ASSERT_NOT_NULL(stack);
+    TEST_ASSERT_INT_EQUALS(getcontext(&fiber), 0);
+    fiber.uc_stack.ss_sp = stack;
+    fiber.uc_stack.ss_size = STACK_SIZE;
+    fiber.uc_link = &scheduler;
+    makecontext(&fiber, run_fiber, 0);
+
+    /* the fiber starts a block nested in this one, while its stack is far away from the one of this thread */
+    TRY {
+        TEST_ASSERT_INT_EQUALS(swapcontext(&scheduler, &fiber), 0);
+    } CATCH (STACK_OVERFLOW) {
+        overflowed = true;
+    }
+    TEST_ASSERT(ran);
+    TEST_ASSERT(!overflowed);
+
+    free(stack);
+    TEST_PASS;
+}
+
+static void run_fiber(void) {
+    TRY {
+        ran = true;
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+#define STACK_SIZE (256 * 1024)
+
+static void * run_parser(void *);
+static void parse(int);
+static void descend(int);
+static volatile int finalized = 0;
+
+/**
+ * Tests that stack overflows can be caught, and that other segmentation faults are not.
+ */
+int main(void) {
+    pthread_t parser;
+    pthread_attr_t attributes;
+    int status;
+
+    e4c_set_context_supplier(e4c_thread_context);
+    if (!e4c_handle_stack_overflow()) {
+        TEST_SKIP("stack overflows cannot be detected in this platform");
+    }
+
+    /* a thread with a small stack overflows it several times */
+    TEST_ASSERT_INT_EQUALS(pthread_attr_init(&attributes), 0);
+    TEST_ASSERT_INT_EQUALS(pthread_attr_setstacksize(&attributes, STACK_SIZE), 0);
+    TEST_ASSERT_INT_EQUALS(pthread_create(&parser, &attributes, run_parser, NULL), 0);
+    TEST_ASSERT_INT_EQUALS(pthread_join(parser, NULL), 0);
+    TEST_ASSERT(finalized > 0);
+
+    /* a null pointer dereference is not a stack overflow */
+    const pid_t child = fork();
+    if (child == 0) {
+        TRY {
+            volatile int * volatile null_pointer = NULL;
+            *null_pointer = 0;
+        } CATCH (STACK_OVERFLOW) {
+            _exit(EXIT_SUCCESS);
+        }
+        _exit(EXIT_SUCCESS);
+    }
+    TEST_ASSERT_INT_EQUALS(waitpid(child, &status, 0), child);
+    TEST_ASSERT(WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+    TEST_PASS;
+}
+
+static void * run_parser(void * _) {
+    (void) _;
+    TEST_ASSERT(e4c_handle_stack_overflow());
+    for (int attempt = 0; attempt < 4; attempt++) {
+        volatile bool caught = false; /* NOSONAR */
+        TRY {
+            /* overflow either when starting an exception block, or in between */
+            if (attempt % 2 == 0) {
+                parse(0);
+            } else {
+                descend(0);
+            }
+        } CATCH (STACK_OVERFLOW) {
+            caught = true;
+            TEST_ASSERT_STR_EQUALS(e4c_get_exception()->name, "STACK_OVERFLOW");
+            TEST_ASSERT_STR_EQUALS(e4c_get_exception()->message, "Stack overflow");
+        }
+        TEST_ASSERT(caught);
+        TEST_ASSERT_INT_EQUALS(e4c_context_reset(e4c_get_context()).blocks, 0);
+    }
+    return NULL;
+}
+
+static void parse(const int depth) {
+    volatile char frame[256];
+    frame[0] = 1;
+    TRY {
+        parse(depth + frame[0]);
+    } FINALLY {
+        finalized++;
+    }
+}
+
+static void descend(const int depth) {
+    volatile char frame[1024];
+    frame[0] = 1;
+    if (depth % 64 == 0) {
+        TRY {
+            descend(depth + frame[0]);
+        } FINALLY {
+            finalized++;
+        }
+    } else {
+        descend(depth + frame[0]);
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdatomic.h>
+#include <exceptions4c-parallel.h>
+#include "testing.h"
+
+#define TASKS 7
+
+static void run(void *);
+static atomic_int runs[TASKS];
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests that task graphs make every task downstream of a failed task fail.
+ */
+int main(void) {
+    volatile bool caught = false; /* NOSONAR */
+    static int ids[TASKS];
+
+    /* the default context supplier is enough, since every thread attaches its own context */
+
+    struct e4c_task_graph * graph = e4c_task_graph_create();
+    for (int id = 0; id < TASKS; id++) {
+        ids[id] = id;
+        TEST_ASSERT_INT_EQUALS(e4c_task_graph_add(graph, run, &ids[id]), id);
+    }
+    e4c_task_graph_depend(graph, 1, 0);
+    e4c_task_graph_depend(graph, 2, 0);
+    e4c_task_graph_depend(graph, 3, 1);
+    e4c_task_graph_depend(graph, 3, 2);
+    e4c_task_graph_depend(graph, 5, 4);
+    e4c_task_graph_depend(graph, 6, 3);
+
+    /* task 1 fails, so tasks 3 and 6 fail too */
+    TEST_ASSERT_INT_EQUALS(e4c_task_graph_run(graph, 3), 3);
+    static const int expected_runs[TASKS] = {1, 1, 1, 0, 1, 1, 0};
+    for (int id = 0; id < TASKS; id++) {
+        TEST_ASSERT_INT_EQUALS(atomic_load(&runs[id]), expected_runs[id]);
+    }
+    TEST_ASSERT_NULL(e4c_task_graph_failure(graph, 0));
+    TEST_ASSERT_NULL(e4c_task_graph_failure(graph, 2));
+    TEST_ASSERT_NULL(e4c_task_graph_failure(graph, 5));
+
+    const struct e4c_exception * failure = e4c_task_graph_failure(graph, 1);
+    TEST_ASSERT_NOT_NULL(failure);
+    TEST_ASSERT_PTR_EQUALS(failure->type, &OOPS);
+
+    failure = e4c_task_graph_failure(graph, 6);
+    TEST_ASSERT_NOT_NULL(failure);
+    TEST_ASSERT_PTR_EQUALS(failure->type, &DEPENDENCY_ERROR);
+    TEST_ASSERT_STR_EQUALS(failure->message, "Task 3 failed");
+    TEST_ASSERT_NOT_NULL(failure->cause);
+    TEST_ASSERT_PTR_EQUALS(failure->cause->type, &DEPENDENCY_ERROR);
+    TEST_ASSERT_STR_EQUALS(failure->cause->message, "Task 1 failed");
+    TEST_ASSERT_PTR_EQUALS(failure->cause->cause, e4c_task_graph_failure(graph, 1));
+
+    /* the graph can run again */
+    TEST_ASSERT_INT_EQUALS(e4c_task_graph_run(graph, 1), 3);
+    TEST_ASSERT_INT_EQUALS(atomic_load(&runs[0]), 2);
+
+    /* graphs with cycles cannot run */
+    e4c_task_graph_depend(graph, 0, 6);
+    TRY {
+        (void) e4c_task_graph_run(graph, 2);
+    } CATCH (PARALLEL_ERROR) {
+        caught = true;
+    }
+    TEST_ASSERT(caught);
+    e4c_task_graph_delete(graph);
+
+    /* empty graphs */
+    graph = e4c_task_graph_create();
+    TEST_ASSERT_INT_EQUALS(e4c_task_graph_run(graph, 4), 0);
+    e4c_task_graph_delete(graph);
+
+    TEST_PASS;
+}
+
+static void run(void * argument) {
+    const int id = *(const int *) argument;
+    atomic_fetch_add(&runs[id], 1);
+    if (id == 1) {
+        THROW(OOPS, "Task %d", id);
+    }
+}
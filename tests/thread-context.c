@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <pthread.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+#define THREADS 4
+
+static void * run_thread(void *);
+static void * exit_thread(void *);
+static void count_finalized(const struct e4c_exception *);
+static volatile int finalized = 0;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+/**
+ * Tests that each thread gets its own exception context, and that the blocks
+ * left behind by an exiting thread are deleted.
+ */
+int main(void) {
+    e4c_get_context()->finalize_exception = count_finalized;
+    e4c_set_context_supplier(e4c_thread_context);
+
+    pthread_t threads[THREADS];
+    struct e4c_context * contexts[THREADS];
+    for (int index = 0; index < THREADS; index++) {
+        TEST_ASSERT_INT_EQUALS(pthread_create(&threads[index], NULL, run_thread, NULL), 0);
+    }
+    for (int index = 0; index < THREADS; index++) {
+        TEST_ASSERT_INT_EQUALS(pthread_join(threads[index], (void **) &contexts[index]), 0);
+        TEST_ASSERT(contexts[index] != e4c_get_context());
+        TEST_ASSERT_INT_EQUALS((int) ((uintptr_t) contexts[index] % 64), 0);
+        for (int other = 0; other < index; other++) {
+            TEST_ASSERT(contexts[index] != contexts[other]);
+        }
+    }
+    TEST_ASSERT_INT_EQUALS(finalized, THREADS * 100);
+
+    /* this thread exits while catching an exception */
+    pthread_t thread;
+    TEST_ASSERT_INT_EQUALS(pthread_create(&thread, NULL, exit_thread, NULL), 0);
+    TEST_ASSERT_INT_EQUALS(pthread_join(thread, NULL), 0);
+    TEST_ASSERT_INT_EQUALS(finalized, THREADS * 100 + 1);
+
+    TEST_ASSERT(e4c_get_exception() == NULL);
+    TEST_PASS;
+}
+
+static void * run_thread(void * _) {
+    (void) _;
+    for (int iteration = 0; iteration < 100; iteration++) {
+        TRY {
+            THROW(OOPS, NULL);
+        } CATCH (OOPS) {
+            if (e4c_get_exception()->type != &OOPS) {
+                return NULL;
+            }
+        }
+    }
+    return e4c_get_context();
+}
+
+static void * exit_thread(void * _) {
+    (void) _;
+    TRY {
+        THROW(OOPS, NULL);
+    } CATCH (OOPS) {
+        pthread_exit(NULL);
+    }
+    return NULL;
+}
+
+static void count_finalized(const struct e4c_exception * _) {
+    (void) _;
+    (void) pthread_mutex_lock(&mutex);
+    finalized++;
+    (void) pthread_mutex_unlock(&mutex);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <time.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+#define SIGNALS 500
+#define ALLOCATORS 4
+
+static void * run_allocator(void *);
+static void * run_target(void *);
+static void throw_on_signal(int);
+static void count_finalized(const struct e4c_exception *);
+static atomic_bool is_armed = false;
+static atomic_bool is_done = false;
+static atomic_int caught = 0;
+static volatile int finalized = 0;
+static const struct e4c_exception_type INTERRUPTED = {NULL, "Interrupted"};
+static const struct e4c_exception_type SUPPRESSED = {NULL, "Suppressed"};
+
+/**
+ * Tests that exceptions can be thrown from signal handlers over and over while other threads hammer the allocator.
+ */
+int main(void) {
+    pthread_t allocators[ALLOCATORS];
+    pthread_t target;
+
+#if EXCEPTIONS4C_BACKEND != EXCEPTIONS4C_BACKEND_SIGSETJMP && EXCEPTIONS4C_BACKEND != EXCEPTIONS4C_BACKEND_UCONTEXT
+    TEST_SKIP("the signal mask cannot be saved by this backend");
+#endif
+
+    e4c_set_context_supplier(e4c_thread_context);
+    struct sigaction action = {0};
+    action.sa_handler = throw_on_signal;
+    TEST_ASSERT_INT_EQUALS(sigaction(SIGUSR1, &action, NULL), 0);
+
+    /* the exception that would be suppressed is not a cause; it is deleted along with the new one */
+    volatile bool interrupted = false;
+    e4c_get_context()->finalize_exception = count_finalized;
+    TRY {
+        TRY_SIGNALSAFE {
+            THROW(SUPPRESSED, NULL);
+        } CATCH (SUPPRESSED) {
+            TEST_ASSERT_INT_EQUALS(finalized, 0);
+        } FINALLY {
+            (void) raise(SIGUSR1);
+        }
+    } CATCH (INTERRUPTED) {
+        interrupted = true;
+        TEST_ASSERT_NULL(e4c_get_exception()->cause);
+    }
+    TEST_ASSERT(interrupted);
+    TEST_ASSERT_INT_EQUALS(finalized, 1);
+    e4c_get_context()->finalize_exception = NULL;
+
+    for (int index = 0; index < ALLOCATORS; index++) {
+        TEST_ASSERT_INT_EQUALS(pthread_create(&allocators[index], NULL, run_allocator, NULL), 0);
+    }
+    TEST_ASSERT_INT_EQUALS(pthread_create(&target, NULL, run_target, NULL), 0);
+
+    /* interrupt the target thread whenever it is ready, giving up after ten seconds */
+    const time_t deadline = time(NULL) + 10;
+    for (int sent = 0; sent < SIGNALS && time(NULL) < deadline;) {
+        if (atomic_exchange(&is_armed, false)) {
+            TEST_ASSERT_INT_EQUALS(pthread_kill(target, SIGUSR1), 0);
+            sent++;
+        }
+        (void) sched_yield();
+    }
+    while (atomic_load(&caught) < SIGNALS && time(NULL) < deadline) {
+        /* wait for the last signal to be handled */
+        (void) sched_yield();
+    }
+
+    atomic_store(&is_done, true);
+    if (atomic_load(&caught) < SIGNALS) {
+        TEST_FAIL("Caught %d of %d signals\n", atomic_load(&caught), SIGNALS);
+    }
+    TEST_ASSERT_INT_EQUALS(pthread_join(target, NULL), 0);
+    for (int index = 0; index < ALLOCATORS; index++) {
+        TEST_ASSERT_INT_EQUALS(pthread_join(allocators[index], NULL), 0);
+    }
+    TEST_PASS;
+}
+
+static void * run_allocator(void * _) {
+    (void) _;
+    for (unsigned int size = 1; !atomic_load(&is_done); size = size * 7 % 4093 + 1) {
+        void * volatile memory = malloc(size);
+        free(memory);
+    }
+    return NULL;
+}
+
+static void * run_target(void * _) {
+    (void) _;
+    while (atomic_load(&caught) < SIGNALS && !atomic_load(&is_done)) {
+        TRY_SIGNALSAFE {
+            atomic_store(&is_armed, true);
+            while (!atomic_load(&is_done)) {
+                /* wait for the signal */
+                (void) sched_yield();
+            }
+        } CATCH (INTERRUPTED) {
+            const struct e4c_exception * exception = e4c_get_exception();
+            if (exception->cause != NULL || e4c_is_uncaught()) {
+                TEST_FAIL("Unexpected exception state\n");
+            }
+            TEST_ASSERT_STR_EQUALS(exception->message, "Interrupted by SIGUSR1");
+            atomic_fetch_add(&caught, 1);
+        }
+    }
+    return NULL;
+}
+
+static void throw_on_signal(int _) {
+    (void) _;
+    THROW_FROM_SIGNAL(INTERRUPTED, "Interrupted by SIGUSR1");
+}
+
+static void count_finalized(const struct e4c_exception * exception) {
+    if (exception->type == &SUPPRESSED) {
+        finalized++;
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <signal.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+static const struct e4c_exception_type USERINT = {NULL, "User interruption"};
+
+static void throw_on_signal(int);
+static bool is_blocked(int);
+
+/**
+ * Tests that a signal can be converted into an exception more than once.
+ */
+int main(void) {
+    volatile int caught = 0; /* NOSONAR */
+
+#if EXCEPTIONS4C_BACKEND != EXCEPTIONS4C_BACKEND_SIGSETJMP && EXCEPTIONS4C_BACKEND != EXCEPTIONS4C_BACKEND_UCONTEXT
+    TEST_SKIP("the signal mask cannot be saved by this backend");
+#endif
+
+    signal(SIGINT, throw_on_signal);
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        TRY_SIGNALSAFE {
+            raise(SIGINT);
+            TEST_FAIL("Reached %s:%d\n", __FILE__, __LINE__);
+        } CATCH (USERINT) {
+            caught++;
+        }
+        TEST_ASSERT_FALSE(is_blocked(SIGINT));
+    }
+
+    TEST_ASSERT_INT_EQUALS(caught, 2);
+    TEST_PASS;
+}
+
+static void throw_on_signal(int _) {
+    (void) _;
+    THROW(USERINT, NULL);
+}
+
+static bool is_blocked(const int signal_number) {
+    sigset_t mask;
+    sigprocmask(SIG_BLOCK, NULL, &mask);
+    return sigismember(&mask, signal_number);
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <signal.h>
+#include <time.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+static volatile long counter = 0;
+static volatile sig_atomic_t forwarded = 0;
+static const struct e4c_exception_type OOPS = {NULL, "Oops"};
+
+static long elapsed(const struct timespec *);
+static void spin(long);
+static void leave_deadline(void);
+static void handle_foreign_signal(int, siginfo_t *, void *);
+
+/**
+ * Tests that TRY_WITHIN blocks throw DEADLINE_EXCEEDED when they do not finish in time.
+ */
+int main(void) {
+    struct timespec start;
+
+#ifndef __linux__
+    TEST_SKIP("deadlines are only enforced in Linux");
+#endif
+
+    /* the deadline signal may be used by somebody else too */
+    struct sigaction action = {0};
+    action.sa_sigaction = handle_foreign_signal;
+    action.sa_flags = SA_SIGINFO;
+    (void) sigemptyset(&action.sa_mask);
+    TEST_ASSERT_INT_EQUALS(sigaction(SIGRTMIN, &action, NULL), 0);
+
+    /* the deadline expires */
+    volatile bool caught = false;
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    TRY_WITHIN(50) {
+        spin(5000);
+    } CATCH (DEADLINE_EXCEEDED) {
+        caught = true;
+    }
+    TEST_ASSERT(caught);
+    TEST_ASSERT(elapsed(&start) >= 50);
+
+    /* the deadline is stopped when the block finishes */
+    TRY_WITHIN(20) {
+        counter++;
+    } CATCH (DEADLINE_EXCEEDED) {
+        TEST_FAIL("Deadline exceeded unexpectedly\n");
+    }
+    spin(100);
+
+    /* inner deadlines cannot extend outer ones */
+    volatile bool outer_caught = false;
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    TRY_WITHIN(50) {
+        TRY_WITHIN(10000) {
+            spin(5000);
+        } CATCH (DEADLINE_EXCEEDED) {
+            /* the outer deadline expired too */
+        }
+        spin(5000);
+    } CATCH (DEADLINE_EXCEEDED) {
+        outer_caught = true;
+    }
+    TEST_ASSERT(outer_caught);
+    TEST_ASSERT(elapsed(&start) < 5000);
+
+    /* outer deadlines keep running after inner ones expire */
+    volatile bool inner_caught = false;
+    outer_caught = false;
+    TRY_WITHIN(10000) {
+        TRY_WITHIN(20) {
+            spin(5000);
+        } CATCH (DEADLINE_EXCEEDED) {
+            inner_caught = true;
+        }
+        spin(100);
+    } CATCH (DEADLINE_EXCEEDED) {
+        outer_caught = true;
+    }
+    TEST_ASSERT(inner_caught);
+    TEST_ASSERT(!outer_caught);
+
+    /* deadlines that expire while the library allocates memory are delivered right after */
+    caught = false;
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    TRY_WITHIN(50) {
+        for (;;) {
+            TRY {
+                THROW(OOPS, "Attempt %ld", counter++);
+            } CATCH (OOPS) {
+                /* the exception is deleted */
+            }
+        }
+    } CATCH (DEADLINE_EXCEEDED) {
+        caught = true;
+    }
+    TEST_ASSERT(caught);
+    TEST_ASSERT(elapsed(&start) < 5000);
+
+    /* deadlines are not delivered while they are deferred */
+    volatile bool deferred = false;
+    caught = false;
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    TRY_WITHIN(20) {
+        e4c_defer_deadlines();
+        spin(100);
+        deferred = true;
+        e4c_resume_deadlines();
+        spin(5000);
+    } CATCH (DEADLINE_EXCEEDED) {
+        caught = true;
+    }
+    TEST_ASSERT(deferred);
+    TEST_ASSERT(caught);
+    TEST_ASSERT(elapsed(&start) < 5000);
+
+    /* signals not sent by deadline timers are forwarded to the previous action */
+    TRY_WITHIN(10000) {
+        e4c_defer_deadlines();
+        (void) raise(SIGRTMIN);
+        e4c_resume_deadlines();
+    } CATCH (DEADLINE_EXCEEDED) {
+        TEST_FAIL("Foreign signal thrown as a deadline\n");
+    }
+    TEST_ASSERT_INT_EQUALS(forwarded, 1);
+
+    /* the deadline of a dangling block is deleted along with it */
+    leave_deadline();
+    (void) e4c_context_reset(e4c_get_context());
+    TRY_WITHIN(10000) {
+        spin(100);
+    } CATCH (DEADLINE_EXCEEDED) {
+        TEST_FAIL("Deadline of a deleted block exceeded\n");
+    }
+
+    TEST_PASS;
+}
+
+static long elapsed(const struct timespec * start) {
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000 + (now.tv_nsec - start->tv_nsec) / 1000000;
+}
+
+static void spin(const long milliseconds) {
+    struct timespec start;
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    while (elapsed(&start) < milliseconds) {
+        counter++;
+    }
+}
+
+static void leave_deadline(void) {
+    TRY_WITHIN(20) {
+        return;
+    }
+}
+
+static void handle_foreign_signal(const int signal_number, siginfo_t * info, void * ucontext) {
+    (void) signal_number;
+    (void) info;
+    (void) ucontext;
+    forwarded++;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <exceptions4c.h>
+#include "testing.h"
+
+static void * work(void *);
+static void hold(int);
+static void report(const struct e4c_context *, const struct e4c_block_snapshot *, void *);
+static atomic_int phase = 0;
+static atomic_int released = 0;
+static _Atomic(struct e4c_context *) worker_context = NULL;
+static int try_line = 0;
+
+/**
+ * Tests that a watchdog can take snapshots of the exception blocks of another thread.
+ */
+int main(void) {
+    struct e4c_block_snapshot blocks[4];
+    pthread_t thread;
+    int reported = 0;
+
+    e4c_set_context_supplier(e4c_thread_context);
+    e4c_enable_context_registry();
+
+    TEST_ASSERT_INT_EQUALS(pthread_create(&thread, NULL, work, NULL), 0);
+
+    /* the worker is trying something inside a nested block */
+    while (atomic_load(&phase) < 1) {
+        continue;
+    }
+    struct e4c_context * context = atomic_load(&worker_context);
+    TEST_ASSERT_INT_EQUALS(e4c_snapshot_context(context, blocks, 4), 2);
+    TEST_ASSERT_INT_EQUALS(blocks[0].stage, E4C_STAGE_TRYING);
+    TEST_ASSERT_INT_EQUALS(blocks[1].stage, E4C_STAGE_TRYING);
+    TEST_ASSERT_STR_CONTAINS(blocks[0].file, "watchdog-snapshot.c");
+    TEST_ASSERT_INT_EQUALS(blocks[0].line, try_line);
+    TEST_ASSERT_STR_EQUALS(blocks[1].function, "work");
+
+    /* the blocks that have been open for too long are reported */
+    (void) nanosleep(&(struct timespec) {0, 20000000}, NULL);
+    TEST_ASSERT_INT_EQUALS(e4c_watchdog_scan(10, report, &reported), 2);
+    TEST_ASSERT_INT_EQUALS(reported, 2);
+    TEST_ASSERT_INT_EQUALS(e4c_watchdog_scan(60000, report, &reported), 0);
+
+    /* the worker is finalizing the outer block */
+    atomic_store(&released, 1);
+    while (atomic_load(&phase) < 2) {
+        continue;
+    }
+    TEST_ASSERT_INT_EQUALS(e4c_snapshot_context(context, blocks, 4), 1);
+    TEST_ASSERT_INT_EQUALS(blocks[0].stage, E4C_STAGE_FINALIZING);
+    TEST_ASSERT(blocks[0].milliseconds >= 20);
+
+    atomic_store(&released, 2);
+    TEST_ASSERT_INT_EQUALS(pthread_join(thread, NULL), 0);
+    TEST_ASSERT_INT_EQUALS(e4c_snapshot_context(e4c_get_context(), blocks, 4), 0);
+    TEST_PASS;
+}
+
+static void * work(void * argument) {
+    (void) argument;
+    atomic_store(&worker_context, e4c_get_context());
+    try_line = __LINE__ + 1;
+    TRY {
+        TRY {
+            hold(1);
+        }
+    } FINALLY {
+        hold(2);
+    }
+    return NULL;
+}
+
+static void hold(const int current) {
+    atomic_store(&phase, current);
+    while (atomic_load(&released) < current) {
+        continue;
+    }
+}
+
+static void report(const struct e4c_context * context, const struct e4c_block_snapshot * block, void * argument) {
+    if (context == atomic_load(&worker_context) && block->stage == E4C_STAGE_TRYING) {
+        (*(int *) argument)++;
+    }
+}